@@ -0,0 +1,189 @@
+#include <vector>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "apsp.hpp"
+#include "matching.hpp"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define APSP_AVX512
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define APSP_AVX2
+#endif
+
+/**
+ * AllPairs Class
+ * Answers S queries by following next hops, in time linear in the path length.
+ */
+AllPairs::AllPairs() : n(0), stride(0) {}
+
+int AllPairs::distance(int u, int v) const {
+    return dist[(size_t)u * stride + v];
+}
+
+/**
+ * Returns the vertices of a shortest u-v path, empty if v is unreachable.
+ */
+std::vector<int> AllPairs::path(int u, int v) const {
+    std::vector<int> vertices;
+    if (next[(size_t)u * stride + v] == -1) {
+        return vertices;
+    }
+    vertices.push_back(u);
+    while (u != v && (int)vertices.size() <= n) {
+        u = next[(size_t)u * stride + v];
+        vertices.push_back(u);
+    }
+    return vertices;
+}
+
+/**
+ * Returns the memory the matrices of an n vertex graph need.
+ */
+size_t AllPairs::bytes(int n) {
+    size_t stride = (size_t)(n + APSP_BLOCK - 1) / APSP_BLOCK * APSP_BLOCK;
+    return stride * stride * 2 * sizeof(int);
+}
+
+/**
+ * Min-plus update of one tile row: di[j] = min(di[j], dik + dk[j]), taking the next hop towards
+ * k wherever the path through k is shorter.
+ */
+static inline void minPlusRow(int* di, int* ni, const int* dk, int dik, int nik) {
+#if defined(APSP_AVX512)
+    const __m512i through = _mm512_set1_epi32(dik);
+    const __m512i hop = _mm512_set1_epi32(nik);
+    for (int j = 0; j < APSP_BLOCK; j += 16) {
+        __m512i candidate = _mm512_add_epi32(through, _mm512_loadu_si512(dk + j));
+        __m512i current = _mm512_loadu_si512(di + j);
+        __mmask16 shorter = _mm512_cmplt_epi32_mask(candidate, current);
+        _mm512_storeu_si512(di + j, _mm512_mask_mov_epi32(current, shorter, candidate));
+        _mm512_storeu_si512(ni + j, _mm512_mask_mov_epi32(_mm512_loadu_si512(ni + j), shorter, hop));
+    }
+#elif defined(APSP_AVX2)
+    const __m256i through = _mm256_set1_epi32(dik);
+    const __m256i hop = _mm256_set1_epi32(nik);
+    for (int j = 0; j < APSP_BLOCK; j += 8) {
+        __m256i candidate = _mm256_add_epi32(through, _mm256_loadu_si256((const __m256i*)(dk + j)));
+        __m256i current = _mm256_loadu_si256((const __m256i*)(di + j));
+        __m256i shorter = _mm256_cmpgt_epi32(current, candidate);
+        __m256i hops = _mm256_loadu_si256((const __m256i*)(ni + j));
+        _mm256_storeu_si256((__m256i*)(di + j), _mm256_min_epi32(current, candidate));
+        _mm256_storeu_si256((__m256i*)(ni + j), _mm256_blendv_epi8(hops, hop, shorter));
+    }
+#else
+    for (int j = 0; j < APSP_BLOCK; j++) {                          // Branch free so the compiler can vectorize it
+        int candidate = dik + dk[j];
+        bool shorter = candidate < di[j];
+        di[j] = shorter ? candidate : di[j];
+        ni[j] = shorter ? nik : ni[j];
+    }
+#endif
+}
+
+/**
+ * Relaxes tile (bi, bj) through every vertex k of tile bk. With k outermost this is plain
+ * Floyd-Warshall inside a tile, so it is also correct for the tiles that share rows or columns
+ * with tile bk.
+ */
+static void relaxTile(AllPairs& paths, int bi, int bj, int bk) {
+    size_t stride = paths.stride;
+    int* dist = paths.dist.data();
+    int* next = paths.next.data();
+
+    for (int k = bk * APSP_BLOCK; k < (bk + 1) * APSP_BLOCK; k++) {
+        const int* dk = dist + k * stride + bj * APSP_BLOCK;
+        for (int i = bi * APSP_BLOCK; i < (bi + 1) * APSP_BLOCK; i++) {
+            int dik = dist[i * stride + k];
+            if (dik >= APSP_INFINITY) {                             // No path to k, nothing to relax
+                continue;
+            }
+            minPlusRow(dist + i * stride + bj * APSP_BLOCK, next + i * stride + bj * APSP_BLOCK, dk, dik, next[i * stride + k]);
+        }
+    }
+}
+
+/**
+ * Relaxes every listed tile through tile bk, with threads taking tiles from a shared counter.
+ */
+static void relaxTiles(AllPairs& paths, const std::vector<std::array<int,2>>& tiles, int bk, int threads) {
+    std::atomic<size_t> ticket(0);
+    auto work = [&]() {
+        for (size_t t = ticket++; t < tiles.size(); t = ticket++) {
+            relaxTile(paths, tiles[t][0], tiles[t][1], bk);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    int workers = std::min<int>(threads, tiles.size());
+    for (int w = 1; w < workers; w++) {
+        pool.push_back(std::thread(work));
+    }
+    work();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+/**
+ * Computes all pairs shortest paths with blocked Floyd-Warshall. For each diagonal tile in turn,
+ * the diagonal tile is closed first, then the tiles in its row and column, then all remaining
+ * tiles, which only read the first two groups and so run in parallel.
+ *
+ * @param graph the weighted adjacency matrix, 0 for no edge
+ * @param n the number of vertices
+ * @param threads the number of threads, 0 for one per hardware thread
+ * @return the distance and next-hop matrices
+ */
+AllPairs allPairsShortestPaths(const std::vector<std::vector<int>>& graph, int n, int threads) {
+    AllPairs paths;
+    int workers = threadCount(threads);
+    paths.n = n;
+    paths.stride = (n + APSP_BLOCK - 1) / APSP_BLOCK * APSP_BLOCK;
+    paths.dist.assign((size_t)paths.stride * paths.stride, APSP_INFINITY);
+    paths.next.assign((size_t)paths.stride * paths.stride, -1);
+
+    for (int i = 0; i < n; i++) {
+        size_t row = (size_t)i * paths.stride;
+        for (int j = 0; j < n; j++) {
+            if (graph[i][j] != 0 && i != j) {
+                paths.dist[row + j] = graph[i][j];
+                paths.next[row + j] = j;
+            }
+        }
+        paths.dist[row + i] = 0;
+        paths.next[row + i] = i;
+    }
+
+    int blocks = paths.stride / APSP_BLOCK;
+    std::vector<std::array<int,2>> cross;
+    std::vector<std::array<int,2>> rest;
+    for (int bk = 0; bk < blocks; bk++) {
+        relaxTile(paths, bk, bk, bk);
+
+        cross.clear();
+        rest.clear();
+        for (int b = 0; b < blocks; b++) {
+            if (b != bk) {
+                cross.push_back({bk, b});
+                cross.push_back({b, bk});
+            }
+        }
+        relaxTiles(paths, cross, bk, workers);
+
+        for (int bi = 0; bi < blocks; bi++) {
+            for (int bj = 0; bj < blocks; bj++) {
+                if (bi != bk && bj != bk) {
+                    rest.push_back({bi, bj});
+                }
+            }
+        }
+        relaxTiles(paths, rest, bk, workers);
+    }
+
+    return paths;
+}
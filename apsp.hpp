@@ -0,0 +1,33 @@
+#ifndef APSP_HPP
+#define APSP_HPP
+
+#include <vector>
+#include <climits>
+#include <cstddef>
+
+const int APSP_INFINITY = INT_MAX / 2;              // Unreachable, and still safe to add to any distance
+const int APSP_BLOCK = 64;                          // Tile side, a 64 x 64 tile of ints is 16 KiB
+
+/**
+ * AllPairs Class
+ * Distance and next-hop matrices of every pair of vertices, stored row major with rows padded
+ * to a whole number of tiles.
+ */
+class AllPairs {
+public:
+    int n;
+    int stride;                                     // Padded row length
+    std::vector<int> dist;
+    std::vector<int> next;                          // First vertex after u on a shortest u-v path, -1 if none
+
+    AllPairs();
+
+    int distance(int u, int v) const;
+    std::vector<int> path(int u, int v) const;
+    static size_t bytes(int n);
+};
+
+AllPairs allPairsShortestPaths(const std::vector<std::vector<int>>& graph, int n, int threads);
+
+
+#endif
@@ -0,0 +1,274 @@
+#include <vector>
+#include <climits>
+
+#include "bipartite.hpp"
+
+/**
+ * Classifies a graph by 2-coloring every component with a BFS. A graph is a forest when it has
+ * exactly n - components edges, and bipartite when no edge joins two vertices of one color.
+ * A self loop makes the graph general. Runs in O(n + m).
+ *
+ * @param graph the graph
+ * @param side receives the color of each vertex when the graph is bipartite, may be nullptr
+ * @return the class of the graph
+ */
+GraphClass classifyGraph(const AdjacencyList& graph, std::vector<char>* side) {
+    int n = graph.n;
+    std::vector<char> color(n, -1);
+    std::vector<int> queue;
+    queue.reserve(n);
+    long long components = 0;
+
+    for (int s = 0; s < n; s++) {
+        if (color[s] != -1) {
+            continue;
+        }
+        ++components;
+        color[s] = 0;
+        queue.clear();
+        queue.push_back(s);
+        for (size_t head = 0; head < queue.size(); head++) {
+            int u = queue[head];
+            for (const int* v = graph.begin(u); v != graph.end(u); ++v) {
+                if (color[*v] == -1) {
+                    color[*v] = 1 - color[u];
+                    queue.push_back(*v);
+                } else if (color[*v] == color[u]) {                 // Odd cycle or self loop
+                    return CLASS_GENERAL;
+                }
+            }
+        }
+    }
+
+    if (side != nullptr) {
+        side->swap(color);
+    }
+    return (long long)graph.edgeCount() == n - components ? CLASS_FOREST : CLASS_BIPARTITE;
+}
+
+/**
+ * Returns a minimum vertex cover of a forest: some minimum cover holds the neighbor of every
+ * leaf, so each leaf's neighbor is taken and both are removed, exposing new leaves. O(n + m).
+ *
+ * @param graph a forest
+ * @return the cover, sorted, vertices numbered from 0
+ */
+std::vector<int> forestVertexCover(const AdjacencyList& graph) {
+    int n = graph.n;
+    std::vector<int> degree(n);
+    std::vector<char> removed(n, 0);
+    std::vector<char> inCover(n, 0);
+    std::vector<int> leaves;
+
+    for (int v = 0; v < n; v++) {
+        degree[v] = graph.degree(v);
+        if (degree[v] == 1) {
+            leaves.push_back(v);
+        }
+    }
+    while (!leaves.empty()) {
+        int leaf = leaves.back();
+        leaves.pop_back();
+        if (removed[leaf] || degree[leaf] != 1) {                   // Its neighbor was already taken
+            continue;
+        }
+        int parent = -1;
+        for (const int* u = graph.begin(leaf); u != graph.end(leaf); ++u) {
+            if (!removed[*u]) {
+                parent = *u;
+                break;
+            }
+        }
+        removed[leaf] = 1;
+        removed[parent] = 1;
+        inCover[parent] = 1;
+        for (const int* u = graph.begin(parent); u != graph.end(parent); ++u) {
+            if (!removed[*u] && --degree[*u] == 1) {
+                leaves.push_back(*u);
+            }
+        }
+    }
+
+    std::vector<int> cover;
+    for (int v = 0; v < n; v++) {
+        if (inCover[v]) {
+            cover.push_back(v);
+        }
+    }
+    return cover;
+}
+
+/**
+ * HopcroftKarp Class
+ * Maximum matching of a bipartite graph in O(m sqrt(n)): each phase layers the graph by a BFS
+ * from the free left vertices, then augments along vertex disjoint shortest paths. The DFS is
+ * iterative, since augmenting paths in large sparse graphs can be very long.
+ */
+class HopcroftKarp {
+    const AdjacencyList& graph;
+    const std::vector<char>& side;
+    std::vector<int> layer;
+    std::vector<const int*> next;                   // Next edge each left vertex's DFS tries
+
+public:
+    std::vector<int> mate;                          // Matched partner of every vertex, -1 if free
+
+    HopcroftKarp(const AdjacencyList& g, const std::vector<char>& s);
+
+    size_t run();
+
+private:
+    bool layers();
+    bool augment(int root);
+};
+
+HopcroftKarp::HopcroftKarp(const AdjacencyList& g, const std::vector<char>& s)
+    : graph(g), side(s), layer(g.n), next(g.n), mate(g.n, -1) {}
+
+/**
+ * Layers the left vertices by alternating distance from a free one.
+ *
+ * @return true if some free right vertex is reachable
+ */
+bool HopcroftKarp::layers() {
+    std::vector<int> queue;
+    bool found = false;
+    for (int u = 0; u < graph.n; u++) {
+        layer[u] = INT_MAX;
+        if (side[u] == 0 && mate[u] == -1) {
+            layer[u] = 0;
+            queue.push_back(u);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        int u = queue[head];
+        for (const int* v = graph.begin(u); v != graph.end(u); ++v) {
+            int w = mate[*v];
+            if (w == -1) {
+                found = true;
+            } else if (layer[w] == INT_MAX) {
+                layer[w] = layer[u] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+    return found;
+}
+
+/**
+ * Searches a layered augmenting path from a free left vertex and flips it. Dead ends are
+ * removed from the layering so no phase explores them twice.
+ */
+bool HopcroftKarp::augment(int root) {
+    std::vector<int> path(1, root);
+    while (!path.empty()) {
+        int u = path.back();
+        if (next[u] == graph.end(u)) {                              // Dead end
+            layer[u] = INT_MAX;
+            path.pop_back();
+            if (!path.empty()) {
+                ++next[path.back()];
+            }
+            continue;
+        }
+        int v = *next[u];
+        int w = mate[v];
+        if (w == -1) {                                              // Flip the path, each left vertex takes its current edge
+            for (int x : path) {
+                int y = *next[x];
+                mate[x] = y;
+                mate[y] = x;
+            }
+            return true;
+        }
+        if (layer[w] == layer[u] + 1) {
+            path.push_back(w);
+        } else {
+            ++next[u];
+        }
+    }
+    return false;
+}
+
+size_t HopcroftKarp::run() {
+    size_t size = 0;
+    while (layers()) {
+        for (int u = 0; u < graph.n; u++) {
+            next[u] = graph.begin(u);
+        }
+        for (int u = 0; u < graph.n; u++) {
+            if (side[u] == 0 && mate[u] == -1 && augment(u)) {
+                ++size;
+            }
+        }
+    }
+    return size;
+}
+
+/**
+ * Returns a minimum vertex cover of a bipartite graph by Konig's theorem. Z is every vertex
+ * reachable from a free left vertex by paths alternating between unmatched and matched edges;
+ * the left vertices outside Z and the right vertices in Z cover every edge, one per matched edge.
+ *
+ * @param graph a bipartite graph
+ * @param side the color of each vertex, 0 for left
+ * @param matching receives the size of the maximum matching, which equals the cover's, may be nullptr
+ * @return the cover, sorted, vertices numbered from 0
+ */
+std::vector<int> bipartiteVertexCover(const AdjacencyList& graph, const std::vector<char>& side, size_t* matching) {
+    HopcroftKarp matcher(graph, side);
+    size_t size = matcher.run();
+    if (matching != nullptr) {
+        *matching = size;
+    }
+
+    std::vector<char> reached(graph.n, 0);
+    std::vector<int> queue;
+    for (int u = 0; u < graph.n; u++) {
+        if (side[u] == 0 && matcher.mate[u] == -1) {
+            reached[u] = 1;
+            queue.push_back(u);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); head++) {           // Left vertices leave by any edge, right ones by their match
+        int u = queue[head];
+        for (const int* v = graph.begin(u); v != graph.end(u); ++v) {
+            if (reached[*v]) {
+                continue;
+            }
+            reached[*v] = 1;
+            int w = matcher.mate[*v];
+            if (w != -1 && !reached[w]) {
+                reached[w] = 1;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    std::vector<int> cover;
+    for (int v = 0; v < graph.n; v++) {
+        if ((side[v] == 0) != (reached[v] == 1)) {
+            cover.push_back(v);
+        }
+    }
+    return cover;
+}
+
+/**
+ * Solves the graph exactly in polynomial time if it is a forest or bipartite.
+ *
+ * @param graph the graph
+ * @param cover receives the minimum cover, sorted, unless the graph is general
+ * @param matching receives the maximum matching size of a bipartite graph, may be nullptr
+ * @return the class of the graph, CLASS_GENERAL if it still needs an exact search
+ */
+GraphClass polynomialVertexCover(const AdjacencyList& graph, std::vector<int>& cover, size_t* matching) {
+    std::vector<char> side;
+    GraphClass type = classifyGraph(graph, &side);
+    if (type == CLASS_FOREST) {
+        cover = forestVertexCover(graph);
+    } else if (type == CLASS_BIPARTITE) {
+        cover = bipartiteVertexCover(graph, side, matching);
+    }
+    return type;
+}
@@ -0,0 +1,22 @@
+#ifndef BIPARTITE_HPP
+#define BIPARTITE_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "graph.hpp"
+
+// Graph classes whose minimum vertex cover takes polynomial time
+enum GraphClass {
+    CLASS_GENERAL,                                  // Needs an exact search
+    CLASS_FOREST,                                   // No cycles, leaf greedy is optimal
+    CLASS_BIPARTITE                                 // No odd cycles, Konig's theorem applies
+};
+
+GraphClass classifyGraph(const AdjacencyList& graph, std::vector<char>* side = nullptr);
+std::vector<int> forestVertexCover(const AdjacencyList& graph);
+std::vector<int> bipartiteVertexCover(const AdjacencyList& graph, const std::vector<char>& side, size_t* matching = nullptr);
+GraphClass polynomialVertexCover(const AdjacencyList& graph, std::vector<int>& cover, size_t* matching = nullptr);
+
+
+#endif
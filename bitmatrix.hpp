@@ -0,0 +1,41 @@
+#ifndef BITMATRIX_HPP
+#define BITMATRIX_HPP
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * BitMatrix Class
+ * Symmetric adjacency matrix storing one bit per vertex pair in rows of 64-bit words.
+ */
+class BitMatrix {
+    int n;
+    int words;                                      // 64-bit words per row
+    std::vector<uint64_t> bits;
+
+public:
+    BitMatrix(int size = 0);
+
+    int size() const;
+    int wordCount() const;
+    bool test(int r, int c) const;
+    void set(int r, int c);
+    void reset(int r, int c);
+    void removeVertex(int v);
+    int degree(int v) const;
+    int commonNeighbors(int a, int b) const;
+    uint64_t* row(int r);
+    const uint64_t* row(int r) const;
+};
+
+int popcount(const uint64_t* a, int words);
+int popcountAnd(const uint64_t* a, const uint64_t* b, int words);
+bool useBitMatrix(int n, size_t m);
+BitMatrix toBitMatrix(int n, const std::vector<std::array<int,2>>& edges);
+std::vector<int> bitGreedyVertexCover(BitMatrix graph);
+std::vector<int> bitGreedyEdgeCover(BitMatrix graph, const std::vector<std::array<int,2>>& edges);
+
+
+#endif
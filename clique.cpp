@@ -0,0 +1,225 @@
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#include "clique.hpp"
+
+/**
+ * Returns the complement of a graph restricted to some of its vertices.
+ *
+ * @param graph the graph
+ * @param vertices the vertices to keep, vertex i of the result is vertices[i]
+ * @return the complement of the induced subgraph
+ */
+BitMatrix complement(const BitMatrix& graph, const std::vector<int>& vertices) {
+    int n = vertices.size();
+    BitMatrix result(n);
+
+    for (int r = 0; r < n; r++) {
+        for (int c = r+1; c < n; c++) {
+            if (!graph.test(vertices[r], vertices[c])) {
+                result.set(r, c);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * CliqueSearch Class
+ * Bit-parallel branch and bound for maximum clique (BBMC, San Segundo et al.). Vertices are
+ * renumbered by non-increasing degree and each node is bounded by a greedy coloring of the
+ * candidate set computed with word-wide operations.
+ */
+class CliqueSearch {
+    int n;
+    int words;
+    std::vector<uint64_t> adj;                      // Renumbered adjacency rows
+    std::vector<std::vector<uint64_t>> candidates;  // Candidate set of each depth
+    std::vector<uint64_t> uncolored;
+    std::vector<uint64_t> colorClass;
+    std::vector<std::vector<int>> order;            // Branching order of each depth
+    std::vector<std::vector<int>> color;
+
+public:
+    std::vector<int> current;
+    std::vector<int> best;
+    long long nodes;
+
+    CliqueSearch(const BitMatrix& graph, const std::vector<int>& rank)
+        : n(graph.size()), words(graph.wordCount()), adj((size_t)n * words, 0),
+          candidates(n + 1, std::vector<uint64_t>(words)), uncolored(words), colorClass(words),
+          order(n + 1), color(n + 1), nodes(0) {
+        for (int u = 0; u < n; u++) {
+            for (int v = 0; v < n; v++) {
+                if (graph.test(rank[u], rank[v])) {
+                    adj[(size_t)u * words + v / 64] |= (uint64_t)1 << (v % 64);
+                }
+            }
+        }
+    }
+
+    /**
+     * Searches all cliques extending current inside the candidates of this depth.
+     */
+    void expand(int depth) {
+        std::vector<uint64_t>& P = candidates[depth];
+        std::vector<int>& vertices = order[depth];
+        std::vector<int>& colors = color[depth];
+        ++nodes;
+
+        // Greedy coloring: vertices with a color below kMin cannot complete a larger clique
+        int kMin = (int)best.size() - (int)current.size() + 1;
+        int k = 0;
+        vertices.clear();
+        colors.clear();
+        uncolored = P;
+        while (any(uncolored)) {
+            ++k;
+            colorClass = uncolored;
+            for (int w = 0; w < words; w++) {
+                while (colorClass[w] != 0) {
+                    int v = w * 64 + __builtin_ctzll(colorClass[w]);
+                    uncolored[w] &= ~((uint64_t)1 << (v % 64));
+                    colorClass[w] &= ~((uint64_t)1 << (v % 64));
+                    const uint64_t* row = &adj[(size_t)v * words];
+                    for (int x = w; x < words; x++) {               // Neighbors of v cannot share its color
+                        colorClass[x] &= ~row[x];
+                    }
+                    if (k >= kMin) {
+                        vertices.push_back(v);
+                        colors.push_back(k);
+                    }
+                }
+            }
+        }
+
+        for (int i = (int)vertices.size() - 1; i >= 0; i--) {      // Highest colors first
+            if ((int)current.size() + colors[i] <= (int)best.size()) {
+                return;
+            }
+            int v = vertices[i];
+            const uint64_t* row = &adj[(size_t)v * words];
+            std::vector<uint64_t>& next = candidates[depth+1];
+            bool empty = true;
+            for (int w = 0; w < words; w++) {
+                next[w] = P[w] & row[w];
+                empty = empty && next[w] == 0;
+            }
+
+            current.push_back(v);
+            if (empty) {
+                if (current.size() > best.size()) {
+                    best = current;
+                }
+            } else {
+                expand(depth+1);
+            }
+            current.pop_back();
+            P[v / 64] &= ~((uint64_t)1 << (v % 64));
+        }
+    }
+
+    void start() {
+        std::vector<uint64_t>& P = candidates[0];
+        for (int v = 0; v < n; v++) {
+            P[v / 64] |= (uint64_t)1 << (v % 64);
+        }
+        expand(0);
+    }
+
+    static bool any(const std::vector<uint64_t>& set) {
+        for (uint64_t w : set) {
+            if (w != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * Finds a maximum clique.
+ *
+ * @param graph the graph
+ * @param initial a known clique used as the first lower bound, may be empty
+ * @param nodes receives the number of search nodes, may be nullptr
+ * @return the vertices of a maximum clique
+ */
+std::vector<int> maxClique(const BitMatrix& graph, const std::vector<int>& initial, long long* nodes) {
+    int n = graph.size();
+    std::vector<int> rank(n);                       // rank[new] = old
+    std::vector<int> degree(n);
+    std::vector<int> position(n);                   // position[old] = new
+
+    for (int v = 0; v < n; v++) {
+        rank[v] = v;
+        degree[v] = graph.degree(v);
+    }
+    std::stable_sort(rank.begin(), rank.end(), [&degree](int a, int b) { return degree[a] > degree[b]; });
+    for (int v = 0; v < n; v++) {
+        position[rank[v]] = v;
+    }
+
+    CliqueSearch search(graph, rank);
+    for (int v : initial) {
+        search.best.push_back(position[v]);
+    }
+    if (n > 0) {
+        search.start();
+    }
+    if (nodes != nullptr) {
+        *nodes = search.nodes;
+    }
+
+    std::vector<int> clique;
+    for (int v : search.best) {
+        clique.push_back(rank[v]);
+    }
+    std::sort(clique.begin(), clique.end());
+    return clique;
+}
+
+/**
+ * Solves minimum vertex cover exactly as the complement of a maximum clique of the complement
+ * graph. The greedy cover seeds the search with a first clique.
+ *
+ * @param graph the graph
+ * @param nodes receives the number of search nodes, may be nullptr
+ * @return the minimum vertex cover, vertices numbered from 0
+ */
+std::vector<int> cliqueVertexCover(const BitMatrix& graph, long long* nodes) {
+    int n = graph.size();
+    std::vector<bool> inCover(n, false);
+    std::vector<int> candidates;                                // A vertex with a self loop is in every cover
+    std::vector<int> index(n, -1);
+    std::vector<int> initial;
+    std::vector<int> vertexCover;
+
+    for (int v = 0; v < n; v++) {
+        if (!graph.test(v, v)) {
+            index[v] = candidates.size();
+            candidates.push_back(v);
+        }
+    }
+
+    for (int v : bitGreedyVertexCover(graph)) {                 // Vertices outside a cover are pairwise non-adjacent
+        inCover[v] = true;
+    }
+    for (int v = 0; v < n; v++) {
+        if (!inCover[v]) {
+            initial.push_back(index[v]);
+        }
+    }
+
+    std::fill(inCover.begin(), inCover.end(), true);
+    for (int v : maxClique(complement(graph, candidates), initial, nodes)) {
+        inCover[candidates[v]] = false;
+    }
+    for (int v = 0; v < n; v++) {
+        if (inCover[v]) {
+            vertexCover.push_back(v);
+        }
+    }
+    return vertexCover;
+}
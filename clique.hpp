@@ -0,0 +1,13 @@
+#ifndef CLIQUE_HPP
+#define CLIQUE_HPP
+
+#include <vector>
+
+#include "bitmatrix.hpp"
+
+BitMatrix complement(const BitMatrix& graph, const std::vector<int>& vertices);
+std::vector<int> maxClique(const BitMatrix& graph, const std::vector<int>& initial, long long* nodes = nullptr);
+std::vector<int> cliqueVertexCover(const BitMatrix& graph, long long* nodes = nullptr);
+
+
+#endif
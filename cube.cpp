@@ -0,0 +1,88 @@
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+
+#include "cube.hpp"
+#include "matching.hpp"
+
+/**
+ * Solves a probe split into cubes, whose disjunction covers every model of its clauses. Each
+ * thread builds one worker and takes the next unsolved cube from a shared ticket counter, so a
+ * thread that finishes early keeps taking work until none is left. The first satisfiable cube
+ * interrupts every other worker; the probe is unsatisfiable once every cube is refuted.
+ *
+ * @param cubes the cubes, each a list of DIMACS literals
+ * @param threads the number of threads, 0 for one per hardware thread
+ * @param makeWorker builds the solver of one thread, called on that thread
+ * @param onSat reads the model of the worker that found one, called once
+ * @param probe receives the cube count and the summed search counters, may be nullptr
+ * @return 10 if some cube is satisfiable, 20 if all are refuted, 0 if a solve was cut short
+ */
+int conquerCubes(const std::vector<std::vector<int>>& cubes, int threads, const std::function<std::unique_ptr<CubeWorker>()>& makeWorker,
+                 const std::function<void(CubeWorker&)>& onSat, ProbeStats* probe) {
+    if (probe != nullptr) {
+        probe->cubes = cubes.size();
+    }
+    if (cubes.empty()) {                                        // Every cube was refuted while splitting
+        return 20;
+    }
+
+    size_t workers = std::min<size_t>(threadCount(threads), cubes.size());
+    std::vector<CubeWorker*> running(workers, nullptr);        // Workers another thread may interrupt
+    std::mutex lock;
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> refuted(0);
+    bool found = false;
+
+    auto work = [&](size_t t) {
+        std::unique_ptr<CubeWorker> worker = makeWorker();
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (found) {
+                return;
+            }
+            running[t] = worker.get();
+        }
+        for (size_t c = next.fetch_add(1); c < cubes.size(); c = next.fetch_add(1)) {
+            int result = worker->solve(cubes[c]);
+            if (result == 20) {
+                refuted++;
+            } else if (result == 10) {
+                std::lock_guard<std::mutex> guard(lock);
+                if (!found) {
+                    found = true;
+                    onSat(*worker);
+                    for (CubeWorker* other : running) {
+                        if (other != nullptr && other != worker.get()) {
+                            other->interrupt();
+                        }
+                    }
+                }
+                break;
+            } else {                                            // Interrupted, another cube is satisfiable
+                break;
+            }
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        running[t] = nullptr;
+        if (probe != nullptr) {
+            worker->addCounters(*probe);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < workers; t++) {
+        pool.push_back(std::thread(work, t));
+    }
+    work(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    if (found) {
+        return 10;
+    }
+    return refuted == cubes.size() ? 20 : 0;
+}
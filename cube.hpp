@@ -0,0 +1,33 @@
+#ifndef CUBE_HPP
+#define CUBE_HPP
+
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "stats.hpp"
+
+/**
+ * CubeWorker Class
+ * One SAT solver of a cube-and-conquer probe, owned by a single thread. It holds the clauses of
+ * the probe and solves them under the literals of one cube at a time.
+ */
+class CubeWorker {
+public:
+    virtual ~CubeWorker() {}
+
+    // Returns 10 if the clauses and the cube literals are satisfiable, 20 if not, 0 if interrupted
+    virtual int solve(const std::vector<int>& cube) = 0;
+    // Stops the current solve from another thread; later solves return 0 at once
+    virtual void interrupt() = 0;
+    // Value of a DIMACS variable in the model of the last satisfiable solve
+    virtual bool value(int var) = 0;
+    // Adds the search counters of every solve so far
+    virtual void addCounters(ProbeStats& probe) = 0;
+};
+
+int conquerCubes(const std::vector<std::vector<int>>& cubes, int threads, const std::function<std::unique_ptr<CubeWorker>()>& makeWorker,
+                 const std::function<void(CubeWorker&)>& onSat, ProbeStats* probe = nullptr);
+
+
+#endif
@@ -1,8 +1,10 @@
 extern "C" {
 #include "kissat.h"  // Include Kissat C API
 }
+#include "kissat-stats.h"
 
 #include <iostream>
+#include <sstream>
 #include <regex>
 #include <algorithm>
 #include <map>
@@ -10,8 +12,28 @@ extern "C" {
 #include <fstream>
 #include <thread>
 #include <future>
+#include <mutex>
+#include <unistd.h>
 
 #include "formatter.hpp"
+#include "encoder.hpp"
+#include "bitmatrix.hpp"
+#include "clique.hpp"
+#include "matching.hpp"
+#include "graph.hpp"
+#include "optimize.hpp"
+#include "loader.hpp"
+#include "generator.hpp"
+#include "weighted.hpp"
+#include "treewidth.hpp"
+#include "bipartite.hpp"
+#include "reorder.hpp"
+#include "cube.hpp"
+#include "planner.hpp"
+#include "sparse.hpp"
+#include "workerpool.hpp"
+#include "options.hpp"
+#include "stats.hpp"
 
 /**
  * Takes input V <int> and returns <int>
@@ -34,22 +56,89 @@ std::array<int,2> cnfCommand(std::string input) {
 }
 
 /**
- * Inputs a line of cnf into the solver
- * ex. 1 2 3 4 0 --> into solver
+ * Inputs every clause of the arena into the solver
+ * ex. 1 2 3 4 --> 1 2 3 4 0 into solver
  */
-int clauseCommand(std::string input, kissat* solver) {
-    std::regex cnfPattern(R"(-?\d+)");                                          // Matches all <int> on a line and optional whitespaces
-    std::smatch s;
+void addClauses(const ClauseArena& arena, kissat* solver) {
+    for (size_t c = 0; c < arena.size(); c++) {
+        const int* lits = arena.clause(c);
+        for (size_t i = 0; i < arena.length(c); i++) {
+            kissat_add(solver, lits[i]);
+        }
+        kissat_add(solver, 0);
+    }
+}
 
-    std::sregex_iterator num(input.begin(), input.end(), cnfPattern);            // After validation of E command format, checks (<int>, <int>, <int>)
-    std::sregex_iterator cnfEnd;
+/**
+ * KissatCubeWorker Class
+ * Cube-and-conquer worker. Kissat has no assumptions and is not incremental, so every cube gets
+ * a fresh solver holding all clauses of the probe plus the cube literals as unit clauses.
+ */
+class KissatCubeWorker : public CubeWorker {
+    const ClauseArena& arena;
+    kissat* solver;                                 // Solver of the last cube, kept for its model
+    std::mutex lock;                                // Guards solver against interrupts from other threads
+    bool stopped;
+    ProbeStats totals;
+
+public:
+    explicit KissatCubeWorker(const ClauseArena& clauses) : arena(clauses), solver(nullptr), stopped(false) {}
+
+    ~KissatCubeWorker() {
+        if (solver != nullptr) {
+            kissat_release(solver);
+        }
+    }
 
-    for (std::sregex_iterator n = num; n != cnfEnd; ++n) {
-        kissat_add(solver, stoi(n->str()));
+    int solve(const std::vector<int>& cube) {
+        kissat* fresh = kissat_init();
+        kissat_set_option(fresh, "phase", 0);
+        addClauses(arena, fresh);
+        for (int lit : cube) {
+            kissat_add(fresh, lit);
+            kissat_add(fresh, 0);
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (stopped) {
+                kissat_release(fresh);
+                return 0;
+            }
+            if (solver != nullptr) {
+                kissat_release(solver);
+            }
+            solver = fresh;
+        }
+
+        int result = kissat_solve(fresh);
+        uint64_t conflicts = 0, decisions = 0, propagations = 0, restarts = 0;
+        kissatCounters(fresh, &conflicts, &decisions, &propagations, &restarts);
+        totals.conflicts += conflicts;
+        totals.decisions += decisions;
+        totals.propagations += propagations;
+        totals.restarts += restarts;
+        return result;
     }
 
-    return 0;
-}
+    void interrupt() {
+        std::lock_guard<std::mutex> guard(lock);
+        stopped = true;
+        if (solver != nullptr) {
+            kissat_terminate(solver);
+        }
+    }
+
+    bool value(int var) {
+        return kissat_value(solver, var) > 0;
+    }
+
+    void addCounters(ProbeStats& probe) {
+        probe.conflicts += totals.conflicts;
+        probe.decisions += totals.decisions;
+        probe.propagations += totals.propagations;
+        probe.restarts += totals.restarts;
+    }
+};
 
 /**
  * Takes a list of edges input (string) and converts it to a integer form
@@ -73,111 +162,125 @@ std::vector<std::array<int,2>> edgeToInt(std::string edgeString) {
 }
 
 /**
- * Takes input V <int> and E {edgeList} and vertex cover size (k) and outputs vertex cover clauses in cnf
+ * Renumbers an edge list from 1..n to 0..n-1, as used by the encoder and the bitset graph
  */
-std::vector<std::string> cnfBuilder(int n, std::vector<std::array<int,2>> edgeList, int k) {
-    std::vector<std::string> cnf = {};                      // Storage for cnf clauses
-    std::vector<std::vector<int>> literals = {};            // Storage for literals
-
-    cnf.push_back("p cnf " + std::to_string(n) + " ");      // Adding first line of cnf
-
-    // Create literals
-    for (int i = 1; i <= n*k; i += n) {
-        std::vector<int> litStorage = {};
-        for ( int lit = i; lit < i+n; lit++) {
-            litStorage.push_back(lit);
-        }
-        literals.push_back(litStorage);
-    }
-
-    // Clause 1
-    for (int i = 0; i < literals.size(); i++) {
-        std::string clauseOne = "";
-        for (int j = 0; j < literals[i].size(); j++) {
-            clauseOne.append(std::to_string(literals[i][j]) + " ");
-        }
-        clauseOne.append("0");
-        cnf.push_back(clauseOne);
-    }
-
-    // Clause 2
-    for (int m = 0; m < n; m++) {
-        for (int q = 0; q < k; q++) {
-            for (int p = 0; p < q; p++) {
-                cnf.push_back( std::to_string(-literals[p][m]) + " " + std::to_string(-literals[q][m]) + " 0" );
-            }
-        }
+std::vector<std::array<int,2>> toZeroIndexed(const std::vector<std::array<int,2>>& edgeList) {
+    std::vector<std::array<int,2>> edges;
+    edges.reserve(edgeList.size());
+    for (const auto& edge : edgeList) {
+        edges.push_back({edge[0]-1, edge[1]-1});
     }
+    return edges;
+}
 
-    // Clause 3
-    for (int m = 0; m < k; m++) {
-        for (int q = 0; q < n; q++) {
-            for (int p = 0; p < q; p++) {
-                cnf.push_back( std::to_string(-literals[m][q]) + " " + std::to_string(-literals[m][p]) + " 0" );
-            }
-        }
+/**
+ * Renumbers a vertex cover from 0..n-1 back to 1..n
+ */
+std::vector<int> toOneIndexed(std::vector<int> vertexCover) {
+    for (size_t i = 0; i < vertexCover.size(); i++) {
+        vertexCover[i] += 1;
     }
+    return vertexCover;
+}
 
-    // Clause 4
-    for (int vertex = 0; vertex < edgeList.size(); vertex++) {
-        std::string clause = "";
-        for (int i = 0; i < k; i++) {
-            clause.append(std::to_string(literals[i][edgeList[vertex][0]-1]) + " ");
-            clause.append(std::to_string(literals[i][edgeList[vertex][1]-1]) + " ");
-        }
-        clause += "0";
-        cnf.push_back(clause);
-    }
+/**
+ * Takes input V <int> and E {edgeList} and vertex cover size (k) and builds the vertex cover clauses into the arena.
+ * The position encoding is used when it fits the memory budget, otherwise the smaller counter encoding.
+ * Position clauses are generated on the given number of threads.
+ */
+Encoding cnfBuilder(int n, const std::vector<std::array<int,2>>& edgeList, int k, long long budget, int threads, ClauseArena& arena) {
+    std::vector<std::array<int,2>> edges = toZeroIndexed(edgeList);
 
-    cnf[0] += std::to_string(cnf.size()-1);
-    return cnf;
+    Encoding encoding = chooseEncoding(n, edges.size(), k, budget);
+    encode(encoding, n, edges, k, arena, threads);
+    return encoding;
 }
 
+// Outcome of one SAT probe
+enum ProbeResult {
+    PROBE_SAT,                          // A cover of at most k vertices was found
+    PROBE_UNSAT,                        // No cover of k vertices exists, the previous one is the minimum
+    PROBE_REFUSED,                      // Neither encoding fits the memory budget
+    PROBE_UNKNOWN                       // The solver stopped without an answer
+};
+
 /**
- * Given clauses in cnf form, returns the vertex cover
+ * Given clauses in cnf form, finds a vertex cover of at most k vertices. Timings and solver counters are written to probe.
+ * With a cube depth set, the probe is split into cubes solved on the given number of threads.
+ *
+ * @param cover receives the cover when the probe is satisfiable
+ * @return whether a cover was found, ruled out, or neither
  */
-std::vector<int> cnfSolver(int n, std::vector<std::array<int,2>> edgeList, int k) {
-    kissat *solver = kissat_init();  // Initialize solver
-    std::vector<int> cover = {};
-    std::vector<std::string> clauses = cnfBuilder(n, edgeList, k);
-    
-    for (int i = 1; i < clauses.size(); i++) {
-        clauseCommand(clauses[i],solver);
-        //std::cout << clauses[i] << std::endl;
+ProbeResult cnfSolver(int n, std::vector<std::array<int,2>> edgeList, int k, long long budget, int threads, int cubeDepth,
+                      std::vector<int>* cover, ProbeStats* probe) {
+    Stopwatch timer;
+    cover->clear();
+    ClauseArena arena;
+    Encoding encoding = cnfBuilder(n, edgeList, k, budget, threads, arena);
+    probe->k = k;
+    probe->encoding = encodingName(encoding);
+    if (encoding == ENCODING_NONE) {
+        std::cerr << "Error: Encoding for k = " << k << " exceeds the memory budget.\n";
+        probe->result = "refused";
+        return PROBE_REFUSED;
     }
+    probe->vars = encodingSize(encoding, n, edgeList.size(), k).vars;
+    probe->clauses = arena.size();
+
+    if (cubeDepth > 0) {
+        std::vector<std::vector<int>> cubes = splitCubes(encoding, n, toZeroIndexed(edgeList), k, cubeDepth);
+        probe->encodeMs = timer.elapsedMs();
+        timer.restart();
+        int result = conquerCubes(cubes, threads, [&arena]() { return std::unique_ptr<CubeWorker>(new KissatCubeWorker(arena)); },
+                                  [&](CubeWorker& worker) {
+                                      *cover = toOneIndexed(decodeCover(encoding, n, k, [&worker](int v) { return worker.value(v); }));
+                                  }, probe);
+        probe->solveMs = timer.elapsedMs();
+        probe->result = result == 10 ? "sat" : (result == 20 ? "unsat" : "unknown");
+        return result == 10 ? PROBE_SAT : (result == 20 ? PROBE_UNSAT : PROBE_UNKNOWN);
+    }
+
+    kissat *solver = kissat_init();  // Initialize solver
+    kissat_set_option(solver, "phase", 0);  // No per-variable phases in Kissat's API, and few variables of a cover are true
+    addClauses(arena, solver);
+    probe->encodeMs = timer.elapsedMs();
 
+    timer.restart();
     int result = kissat_solve(solver);  // Solve
-    
+    probe->solveMs = timer.elapsedMs();
+    kissatCounters(solver, &probe->conflicts, &probe->decisions, &probe->propagations, &probe->restarts);
+
+    timer.restart();
     if (result == 10) {  // 10 = SAT
+        probe->result = "sat";
         //std::cout << "SATISFIABLE\n";  
         
-        for (int i = 0; i < k; i++) {
-            for (int j = 1; j <= n; j++) {
-                int value = kissat_value(solver, j + n*i);
-                if (value > 0) {
-                    cover.push_back(j);
-                }
-            }
-        }
-        std::sort(cover.begin(), cover.end());
+        *cover = toOneIndexed(decodeCover(encoding, n, k, [solver](int v) { return kissat_value(solver, v) > 0; }));
 
     } else if (result == 20) {  // 20 = UNSAT
         //std::cout << "UNSATISFIABLE\n";
+        probe->result = "unsat";
+    } else {
+        probe->result = "unknown";
     }
+    probe->decodeMs = timer.elapsedMs();
 
     kissat_release(solver);  // Free solver memory
 
-    return cover;
+    return result == 10 ? PROBE_SAT : (result == 20 ? PROBE_UNSAT : PROBE_UNKNOWN);
 }
 
 /**
- * Prints vertexCover
+ * Prints vertexCover, naming vertex v labels[v-1] when labels are given
  */
-std::string printVertexCover(std::vector<int> vertexCover) {
+std::string printVertexCover(std::vector<int> vertexCover, const std::vector<int>& labels = std::vector<int>()) {
     std::string vc = "";
+    for (size_t i = 0; i < vertexCover.size(); i++) {        // Sorted by printed name, vertices may be reordered
+        vertexCover[i] = labels.empty() ? vertexCover[i] : labels[vertexCover[i]-1];
+    }
     std::sort(vertexCover.begin(), vertexCover.end());
 
-    for (int i = 0; i < vertexCover.size(); i++) {
+    for (size_t i = 0; i < vertexCover.size(); i++) {
         vc.append(std::to_string(vertexCover[i]) + " ");
     }
     vc.append("(" + std::to_string(vertexCover.size()) + ")");          // NOTE: PRINTING FOR ASSIGNEMENT
@@ -185,6 +288,37 @@ std::string printVertexCover(std::vector<int> vertexCover) {
     return vc;
 }
 
+/**
+ * Removes redundant vertices and makes 2-for-1 swaps in a heuristic cover when enabled.
+ * Vertices are numbered from 1 in and out, the saving is recorded under the given name.
+ */
+std::vector<int> improveVertexCover(const std::vector<int>& vertexCover, const std::vector<std::array<int,2>>& edgeList, int n,
+                                    const SolverOptions& options, GraphStats& stats, const std::string& name) {
+    if (!options.improve) {
+        return vertexCover;
+    }
+    std::vector<int> cover;
+    for (int vertex : vertexCover) {
+        cover.push_back(vertex - 1);
+    }
+    ImproveResult result = improveCover(buildAdjacency(n, toZeroIndexed(edgeList)), cover);
+    stats.counters[name + "_removed"] = result.removed;
+    stats.counters[name + "_swaps"] = result.swaps;
+    return toOneIndexed(result.cover);
+}
+
+/**
+ * Post-optimizes a cover found on the way to the exact one, whatever --no-improve says, since it
+ * only tightens the bound of the next probe. Vertices are numbered from 1 in and out.
+ */
+std::vector<int> tightenCover(const AdjacencyList& graph, const std::vector<int>& vertexCover) {
+    std::vector<int> cover;
+    for (int vertex : vertexCover) {
+        cover.push_back(vertex - 1);
+    }
+    return toOneIndexed(improveCover(graph, cover).cover);
+}
+
 // ================= Greedy Solver Functions Below =================
 
 /**
@@ -214,6 +348,10 @@ std::map<int,std::vector<int>> createEdgeMap(std::vector<std::array<int,2>> edge
  * Creates vertex cover for greedysolver 1 algorithm
  */
 std::vector<int> greedySolver1(std::vector<std::array<int,2>> edgeList, int n) {
+    if (useBitMatrix(n, edgeList.size())) {                 // Dense graphs use the bitset adjacency
+        return toOneIndexed(bitGreedyVertexCover(toBitMatrix(n, toZeroIndexed(edgeList))));
+    }
+
     std::map<int,std::vector<int>> edgesDict = createEdgeMap(edgeList, n);
     std::vector<int> vertexCover = {};
     std::vector<int> removeVertex;                          // Storage for vertices to be removed from edgesDict
@@ -255,6 +393,11 @@ std::vector<int> greedySolver1(std::vector<std::array<int,2>> edgeList, int n) {
  * Creates vertex cover for greedysolver 2 algorithm
  */
 std::vector<int> greedySolver2(std::vector<std::array<int,2>> edgeList, int n) {
+    if (useBitMatrix(n, edgeList.size())) {                 // Dense graphs use the bitset adjacency
+        std::vector<std::array<int,2>> edges = toZeroIndexed(edgeList);
+        return toOneIndexed(bitGreedyEdgeCover(toBitMatrix(n, edges), edges));
+    }
+
     std::map<int,std::vector<int>> edgesDict = createEdgeMap(edgeList, n);
     std::vector<int> vertexCover = {};
     std::vector<std::array<int,2>> removeEdge;                          // Storage for vertices to be removed from edgesDict
@@ -338,68 +481,328 @@ void writeToFile(const std::string& data) {
     }
 }
 
-int main() {
-    int v;
-    //int k = 1;
-    std::string command;
-    std::vector<std::array<int,2>> edgeList = {};
+/**
+ * Solves one graph: exact cover by SAT probes or clique search, then the greedy and, if requested,
+ * approximate covers. Vertices are numbered from 1. --quality=exact drops the greedy covers,
+ * --quality=heuristic the exact cover unless it is found without search.
+ */
+void solveGraph(int v, const std::vector<std::array<int,2>>& edgeList, const SolverOptions& options, GraphStats& stats,
+                const std::vector<int>& labels = std::vector<int>()) {
+    Stopwatch timer;
+    AdjacencyList graph = buildAdjacency(v, toZeroIndexed(edgeList));
+    std::vector<int> minVertexCover = tightenCover(graph, greedySolver1(edgeList, v));  // Every k at or above its size is satisfiable
     std::vector<int> vertexCover = {};
+    int maxK = minVertexCover.size() - 1;
+    bool timedOut = false;
+    bool unproven = false;                  // A probe was refused or gave no answer, the cover may not be minimum
+    stats.kernelMs = timer.elapsedMs();
+    stats.counters["exact_upper_bound"] = minVertexCover.size();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto end = start;
+    if (options.quality != "exact") {
+        start = std::chrono::high_resolution_clock::now();      // Solves greedysolver 1 and records data
+        writeToFile("VC-GREEDY-1: " + printVertexCover(improveVertexCover(greedySolver1(edgeList, v), edgeList, v, options, stats, "greedy1"), labels) + "\n");
+        end = std::chrono::high_resolution_clock::now();
+        writeToFile("Execution time: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) + "\n");
+
+        start = std::chrono::high_resolution_clock::now();      // Solves greedysolver 2 and records data
+        writeToFile("VC-GREEDY-2: " + printVertexCover(improveVertexCover(greedySolver2(edgeList, v), edgeList, v, options, stats, "greedy2"), labels) + "\n");
+        end = std::chrono::high_resolution_clock::now();
+        writeToFile("Execution time: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) + "\n");
+    }
+
+    timer.restart();
+    start = std::chrono::high_resolution_clock::now();
+    bool search = options.quality != "heuristic";
+    std::string exact = options.exact;
+    int cubeDepth = options.cubes;
+    GraphFeatures features;
+    EnginePlan plan;
+    double featuresMs = 0;
+    if (exact == "auto") {                  // The planner picks the engine, SAT unless another is predicted faster
+        features = graphFeatures(graph, toZeroIndexed(edgeList), search ? options.treewidth : 0, options.threads);
+        plan = planExactEngine(features, options);
+        featuresMs = timer.elapsedMs();
+        exact = engineName(plan.engine);
+        cubeDepth = plan.cubeDepth;
+    }
+    std::vector<int> classCover;
+    if (exact == "bound") {                 // The improved greedy cover meets the matching lower bound
+        minVertexCover = toOneIndexed(features.upper);
+        maxK = 0;
+    } else if (maxK > 0 && polynomialVertexCover(graph, classCover) != CLASS_GENERAL) {   // Forests and bipartite graphs need no search
+        minVertexCover = toOneIndexed(classCover);
+        maxK = 0;
+    } else if (search && exact == "clique") {   // Maximum clique of the complement graph instead of SAT probes
+        long long nodes = 0;
+        minVertexCover = toOneIndexed(cliqueVertexCover(toBitMatrix(v, toZeroIndexed(edgeList)), &nodes));
+        stats.counters["clique_nodes"] = nodes;
+        maxK = 0;                       // Skips the k loop
+    } else if (search && maxK > 0 && (options.exact == "sat" || exact == "treewidth") && options.treewidth > 0) {     // Narrow graphs are solved by the tree decomposition DP
+        std::vector<int> narrowCover;
+        int width = -1;
+        if (treewidthVertexCover(graph, options.treewidth, options.memBudget, narrowCover, &width)) {
+            minVertexCover = toOneIndexed(narrowCover);
+            maxK = 0;
+        }
+        stats.counters["treewidth"] = width;
+    }
+    bool skipped = !search && maxK > 0;     // No cover is known to be minimum without search
+    if (skipped) {
+        maxK = 0;
+    }
+    long long budget = options.memBudget;
+    if (cubeDepth > 0 && budget > 0) {      // Every cube worker holds its own copy of the clauses
+        budget /= threadCount(options.threads);
+    }
+    while (maxK > 0) {      // Loops through different values of k to find optimal solution
+        ProbeStats probe;   // Declared before the future, which blocks on destruction until the solver thread is done
+        auto test = async(std::launch::async, cnfSolver, v, edgeList, maxK, budget, options.threads, cubeDepth, &vertexCover, &probe);    // Launches a timer thread
+        ProbeResult result = PROBE_UNKNOWN;
+        if (test.wait_for(std::chrono::minutes(10)) == std::future_status::ready) {     // Waits 10 minutes for solver
+            result = test.get();
+            stats.probes.push_back(probe);
+            stats.decodeMs += probe.decodeMs;
+        } else {            // If timer runs out, records previous iteration of vertex cover
+            //std::cout << "TIMEOUT!" << std::endl;
+            ProbeStats timedOutProbe;           // The solver thread still owns probe
+            timedOutProbe.k = maxK;
+            timedOutProbe.result = "timeout";
+            stats.probes.push_back(timedOutProbe);
+            minVertexCover = improveVertexCover(minVertexCover, edgeList, v, options, stats, "timeout");
+            writeToFile("VC (non-optimal): " + printVertexCover(minVertexCover, labels) + "\n");
+            timedOut = true;
+            break;
+        }
+
+        if (result == PROBE_UNSAT) {        // Unsatisfiable, the previous cover is the minimum
+            break;
+        }
+        if (result != PROBE_SAT) {          // Refused or unknown, nothing is proven about k
+            unproven = true;
+            break;
+        }
+        minVertexCover = tightenCover(graph, vertexCover);  // Satisfiable, the optimized model can skip several k
+        maxK = minVertexCover.size() - 1;
+    }
+    if (unproven) {
+        std::cout << "VC (non-optimal): " << printVertexCover(minVertexCover, labels) << std::endl;
+        writeToFile("VC (non-optimal): " + printVertexCover(minVertexCover, labels) + "\n");
+    } else if (!timedOut && !skipped) {     // Also reached when every k down to 1 is satisfiable
+        std::cout << "VC-EXACT: " << printVertexCover(minVertexCover, labels) << std::endl;
+        writeToFile("VC-EXACT: " + printVertexCover(minVertexCover, labels) + "\n");
+    }
+    end = std::chrono::high_resolution_clock::now();
+    writeToFile("Execution time: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) + "\n\n");
+    stats.engineMs["exact"] = timer.elapsedMs();
+    if (options.exact == "auto") {
+        recordPlan(stats, features, plan, featuresMs, stats.engineMs["exact"] - featuresMs);
+    }
+
+    if (options.quality != "exact") {
+        timer.restart();
+        std::cout << "VC-GREEDY-1: " << printVertexCover(improveVertexCover(greedySolver1(edgeList, v), edgeList, v, options, stats, "greedy1"), labels) << std::endl;
+        stats.engineMs["greedy1"] = timer.elapsedMs();
+
+        timer.restart();
+        std::cout << "VC-GREEDY-2: " << printVertexCover(improveVertexCover(greedySolver2(edgeList, v), edgeList, v, options, stats, "greedy2"), labels) << std::endl;
+        stats.engineMs["greedy2"] = timer.elapsedMs();
+    }
+
+    if (options.approx) {               // Maximal matching, at most twice the minimum
+        timer.restart();
+        MatchingCover approx = matchingVertexCover(v, toZeroIndexed(edgeList), options.threads);
+        approx.cover = improveVertexCover(toOneIndexed(approx.cover), edgeList, v, options, stats, "approx");
+        std::cout << "VC-APPROX: " << printVertexCover(approx.cover, labels) << std::endl;
+        std::cout << "VC-APPROX-LB: " << approx.lowerBound << std::endl;
+        stats.engineMs["approx"] = timer.elapsedMs();
+        stats.counters["matching_lower_bound"] = approx.lowerBound;
+    }
+}
+
+/**
+ * Solves one graph with vertex weights: minimum weight cover by branch and bound, then the
+ * ratio greedy and pricing covers. Vertices are numbered from 1.
+ */
+void solveWeighted(int v, const std::vector<std::array<int,2>>& edgeList, const std::vector<long long>& weights,
+                   const SolverOptions& options, GraphStats& stats, const std::vector<int>& labels = std::vector<int>()) {
+    std::vector<std::array<int,2>> edges = toZeroIndexed(edgeList);
+    Stopwatch timer;
+    AdjacencyList graph = buildAdjacency(v, edges);
+    stats.kernelMs = timer.elapsedMs();
+
+    if (options.quality != "heuristic") {
+        timer.restart();
+        long long nodes = 0;
+        std::vector<int> cover = weightedExactCover(graph, weights, &nodes);
+        stats.counters["weighted_nodes"] = nodes;
+        std::cout << weightedCoverFormatter("VC-WEIGHTED-EXACT", cover, weights, labels) << std::endl;
+        writeToFile(weightedCoverFormatter("VC-WEIGHTED-EXACT", cover, weights, labels) + "\n");
+        stats.engineMs["weighted_exact"] = timer.elapsedMs();
+    }
+
+    if (options.quality != "exact") {
+        timer.restart();
+        std::vector<int> cover = ratioGreedyCover(graph, weights);
+        if (options.improve) {
+            ImproveResult result = improveCover(graph, cover, &weights);
+            cover = result.cover;
+            stats.counters["weighted_greedy_removed"] = result.removed;
+            stats.counters["weighted_greedy_swaps"] = result.swaps;
+        }
+        std::cout << weightedCoverFormatter("VC-WEIGHTED-GREEDY", cover, weights, labels) << std::endl;
+        stats.engineMs["weighted_greedy"] = timer.elapsedMs();
+    }
+
+    timer.restart();                    // Pricing method, at most twice the minimum weight
+    PricingCover approx = pricingVertexCover(v, edges, weights);
+    if (options.improve) {
+        ImproveResult result = improveCover(graph, approx.cover, &weights);
+        approx.cover = result.cover;
+        stats.counters["weighted_approx_removed"] = result.removed;
+        stats.counters["weighted_approx_swaps"] = result.swaps;
+    }
+    std::cout << weightedCoverFormatter("VC-WEIGHTED-APPROX", approx.cover, weights, labels) << std::endl;
+    std::cout << "VC-WEIGHTED-APPROX-LB: " << approx.lowerBound << std::endl;
+    stats.engineMs["weighted_approx"] = timer.elapsedMs();
+    stats.counters["pricing_lower_bound"] = approx.lowerBound;
+}
+
+/**
+ * Runs the V, W and E commands read from a stream, solving each graph when its E command arrives.
+ *
+ * @param in the commands
+ * @param options the command line options
+ * @param graphCount the number of graphs solved before, to number the stats lines
+ */
+void processCommands(std::istream& in, const SolverOptions& options, int graphCount) {
+    GraphStats stats;
+    int v = 0;
+    std::vector<std::array<int,2>> edgeList = {};
+    std::vector<long long> weights = {};
 
     std::string line;
-    while (!(getline(std::cin, line)).eof()) {
+    while (!(getline(in, line)).eof()) {
 
         if (line[0] == 'V') {               // Checks for V commands
             v = vertexCommand(line);
+            weights.clear();
             writeToFile(std::to_string(v) + "\n");
+        } else if (line[0] == 'W') {        // Checks for W commands, vertex weights before E
+            std::vector<std::array<int,2>> wInput = wCommand(line);
+            std::vector<std::array<int,2>> errorInput = { { -1, -1 } };
+            if (wInput != errorInput) {
+                for (const auto& weight : wInput) {     // Same rules and message as Matrix::setVertexWeight
+                    if (weight[0] < 1 || weight[0] > v || weight[1] < 0) {
+                        std::cerr << "Error: Vertex weight (" << weight[0] << ", " << weight[1] << ") is out of bounds.\n";
+                        continue;
+                    }
+                    if (weights.empty()) {
+                        weights.assign(v, 1);
+                    }
+                    weights[weight[0]-1] = weight[1];
+                }
+            }
         } else if (line[0] == 'E') {        // Checks for E commands
+            Stopwatch timer;
             edgeList = edgeToInt(line);
-
-            std::vector<int> kUpperBound = greedySolver1(edgeList, v);
-            std::vector<int> minVertexCover = {};
-            std::vector<int> vertexCover = {};
-            int maxK = kUpperBound.size();
-
-            auto start = std::chrono::high_resolution_clock::now();     // Solves greedysolver 1 and records data
-            writeToFile("VC-GREEDY-1: " + printVertexCover(greedySolver1(edgeList, v)) + "\n");
-            auto end = std::chrono::high_resolution_clock::now();
-            writeToFile("Execution time: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) + "\n");
-
-            start = std::chrono::high_resolution_clock::now();          // Solves greedysolver 2 and records data
-            writeToFile("VC-GREEDY-2: " + printVertexCover(greedySolver2(edgeList, v)) + "\n");
-            end = std::chrono::high_resolution_clock::now();
-            writeToFile("Execution time: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) + "\n");
-
-            while (maxK > 0) {      // Loops through different values of k to find optimal solution
-                start = std::chrono::high_resolution_clock::now();
-                auto test = async(std::launch::async, cnfSolver, v, edgeList, maxK);            // Launches a timer thread
-                if (test.wait_for(std::chrono::minutes(10)) == std::future_status::ready) {     // Waits 10 minutes for solver
-                    vertexCover = test.get();
-                } else {            // If timer runs out, records previous iteration of vertex cover
-                    //std::cout << "TIMEOUT!" << std::endl;
-                    writeToFile("VC (non-optimal): " + printVertexCover(minVertexCover) + "\n");
-                    end = std::chrono::high_resolution_clock::now();
-                    writeToFile("Execution time: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) + "\n\n");
-                    //exit(1);
-                    break;
-                }
-
-                if (vertexCover.size() == 0) {      // If vertex cover is 0, unsatisfiable, return previous iteration of vertex cover
-                    std::cout << "VC-EXACT: " << printVertexCover(minVertexCover) << std::endl;
-                    writeToFile("VC-EXACT: " + printVertexCover(minVertexCover) + "\n");
-                    end = std::chrono::high_resolution_clock::now();
-                    writeToFile("Execution time: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) + "\n\n");
-                    break;
-                } else {                            // Else, vertex cover is satisfiable, record data and continue to check next iteration of k
-                    minVertexCover = vertexCover;
+            bool inBounds = true;
+            for (const auto& edge : edgeList) {     // Same check and message as Matrix::set
+                if (edge[0] < 1 || edge[1] < 1 || edge[0] > v || edge[1] > v) {
+                    std::cerr << "Error: Edge (" << edge[0]-1 << ", " << edge[1]-1 << ") is out of bounds.\n";
+                    inBounds = false;
                 }
-                --maxK;
+            }
+            if (!inBounds) {
+                continue;
+            }
+            stats = GraphStats();
+            stats.id = ++graphCount;
+            stats.vertices = v;
+            stats.edges = edgeList.size();
+            stats.parseMs = timer.elapsedMs();
+
+            if (weights.empty()) {
+                solveGraph(v, edgeList, options, stats);
+            } else {
+                solveWeighted(v, edgeList, weights, options, stats);
             }
 
-            std::cout << "VC-GREEDY-1: " << printVertexCover(greedySolver1(edgeList, v)) << std::endl;
-            std::cout << "VC-GREEDY-2: " << printVertexCover(greedySolver2(edgeList, v)) << std::endl;
+            if (options.stats) {
+                emitStats(stats, options.statsPath);
+            }
         } 
 
     }
+}
 
+int main(const int argc, const char* argv[]) {
+    SolverOptions options = parseOptions(argc, argv);
+    GraphStats stats;
+    std::vector<std::array<int,2>> edgeList = {};
+
+    if (!options.input.empty() || !options.generate.empty()) {  // Solves one graph file or generated graph instead of reading stdin
+        LoadedGraph loaded;
+        GeneratorSpec spec;
+        std::vector<int> planted;
+        Stopwatch timer;
+        if (!options.generate.empty()) {
+            if (!parseGeneratorSpec(options.generate, spec) || !generateGraph(spec, loaded, &planted)) {
+                return 1;
+            }
+        } else if (!loadGraph(options.input, formatFromName(options.format), options.threads, loaded)) {
+            return 1;
+        }
+        stats.id = 1;
+        stats.vertices = loaded.n;
+        stats.edges = loaded.edges.size();
+        stats.parseMs = timer.elapsedMs();
+        VertexOrder order = ORDER_NONE;
+        if (parseVertexOrder(options.reorder, order) && order != ORDER_NONE) {     // Covers keep the file ids through the labels
+            timer.restart();
+            relabelGraph(loaded, vertexOrder(buildAdjacency(loaded.n, loaded.edges), order));
+            stats.engineMs["reorder"] = timer.elapsedMs();
+        }
+
+        if (loaded.n > MATRIX_LIMIT) {      // Linear time heuristics and the exact engines without search
+            solveSparse(loaded, options, stats);
+        } else {
+            edgeList.reserve(loaded.edges.size());
+            for (const auto& edge : loaded.edges) {
+                edgeList.push_back({edge[0]+1, edge[1]+1});
+            }
+
+            if (loaded.weights.empty()) {
+                solveGraph(loaded.n, edgeList, options, stats, loaded.labels);
+            } else {
+                solveWeighted(loaded.n, edgeList, loaded.weights, options, stats, loaded.labels);
+            }
+        }
+        if (!options.generate.empty() && spec.family == FAMILY_PLANTED) {
+            std::cout << "VC-PLANTED: " << printVertexCover(toOneIndexed(planted)) << std::endl;
+            writeToFile("VC-PLANTED: " + printVertexCover(toOneIndexed(planted)) + "\n");
+        }
+
+        if (options.stats) {
+            emitStats(stats, options.statsPath);
+        }
+        return 0;
+    }
+
+    if (options.workers > 0) {          // Each graph on a worker process, a crash or limit loses only that graph
+        if (options.threads == 0) {
+            options.threads = std::max(1, threadCount(0) / options.workers);
+        }
+        WorkerLimits limits;
+        limits.rssBytes = options.workerRss;
+        limits.seconds = options.workerTime;
+        int failed = superviseWorkers(STDIN_FILENO, options.workers, limits, [&options](const std::string& job, int graphsBefore) {
+            std::istringstream in(job);
+            processCommands(in, options, graphsBefore);
+        });
+        return failed == 0 ? 0 : 1;
+    }
+    processCommands(std::cin, options, 0);
     return 0;
 }
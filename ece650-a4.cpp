@@ -1,11 +1,27 @@
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <array>
-#include <chrono>
+#include <algorithm>
+#include <unistd.h>
 
 #include "matrix.hpp"
 #include "formatter.hpp"
+#include "matching.hpp"
+#include "graph.hpp"
+#include "optimize.hpp"
+#include "loader.hpp"
+#include "generator.hpp"
+#include "weighted.hpp"
+#include "treewidth.hpp"
+#include "bipartite.hpp"
+#include "reorder.hpp"
+#include "planner.hpp"
+#include "sparse.hpp"
+#include "workerpool.hpp"
+#include "options.hpp"
+#include "stats.hpp"
 
 // defined std::unique_ptr
 #include <memory>
@@ -18,18 +34,198 @@
 #include <iostream>
  
 
-int main(const int argc, const char* argv[]) {
-    // Test code. Replaced with your code
+/**
+ * Prints the minimum weight, ratio greedy and pricing covers of a graph with vertex weights.
+ * Each line ends with the total weight of the cover in brackets.
+ */
+void solveWeighted(Matrix& graph, int size, const SolverOptions& options, GraphStats& stats, const std::vector<int>& labels) {
+    Stopwatch timer;
+    if (options.quality != "heuristic") {
+        std::cout << graph.vcWeightedExact() << std::endl;
+        stats.engineMs["weighted_exact"] = timer.elapsedMs();
+    }
+
+    if (options.quality != "exact") {
+        timer.restart();
+        std::cout << graph.weightedGreedySolver() << std::endl;
+        stats.engineMs["weighted_greedy"] = timer.elapsedMs();
+    }
+
+    timer.restart();                                    // Pricing method, at most twice the minimum weight
+    PricingCover approx = pricingVertexCover(size, graph.edges(), graph.weights());
+    approx.cover = improveHeuristicCover(buildAdjacency(size, graph.edges()), approx.cover, options, stats, "weighted_approx", &graph.weights());
+    std::cout << weightedCoverFormatter("VC-WEIGHTED-APPROX", approx.cover, graph.weights(), labels) << std::endl;
+    std::cout << "VC-WEIGHTED-APPROX-LB: " << approx.lowerBound << std::endl;
+    stats.engineMs["weighted_approx"] = timer.elapsedMs();
+    stats.counters["pricing_lower_bound"] = approx.lowerBound;
+}
+
+/**
+ * Returns the minimum cover from the exact engine the planner predicts to be fastest for the
+ * features of the graph, recording the choice and the predicted and actual times. Empty when
+ * --quality=heuristic leaves no engine that needs no search.
+ */
+std::string exactAuto(Matrix& graph, int size, const SolverOptions& options, GraphStats& stats, const std::vector<int>& labels) {
+    Stopwatch timer;
+    int treewidthLimit = options.quality == "heuristic" ? 0 : options.treewidth;      // No DP is run for heuristic covers
+    GraphFeatures features = graphFeatures(buildAdjacency(size, graph.edges()), graph.edges(), treewidthLimit, options.threads);
+    EnginePlan plan = planExactEngine(features, options);
+    double featuresMs = timer.elapsedMs();
+
+    timer.restart();
+    std::string cover;
+    if (plan.engine == ENGINE_BOUND) {
+        cover = coverFormatter("VC-EXACT", features.upper, labels);
+    } else if (plan.engine == ENGINE_POLYNOMIAL) {
+        cover = graph.vcPolynomial();
+    } else if (plan.engine == ENGINE_TREEWIDTH) {
+        cover = graph.vcTreewidth(options.treewidth);
+    } else if (plan.engine == ENGINE_CLIQUE) {
+        cover = graph.vcClique();
+    }
+    if (cover.empty() && plan.engine != ENGINE_NONE) {  // SAT, or a DP whose tables outgrew the prediction
+        graph.setCubeDepth(plan.cubeDepth);
+        cover = graph.vcExact(size);
+        graph.setCubeDepth(options.cubes);
+    }
+    recordPlan(stats, features, plan, featuresMs, timer.elapsedMs());
+    return cover;
+}
+
+/**
+ * Prints the exact, greedy and, if requested, approximate covers of a graph held in a Matrix.
+ * --quality=exact drops the greedy covers, --quality=heuristic the exact cover unless a forest,
+ * bipartite or bound check finds it without search.
+ *
+ * @param graph the graph
+ * @param size the number of vertices
+ * @param options the command line options
+ * @param stats the statistics of the graph
+ * @param labels the printed name of each vertex, empty to number them from 1
+ */
+void solveGraph(Matrix& graph, int size, const SolverOptions& options, GraphStats& stats, const std::vector<int>& labels = std::vector<int>()) {
+    Stopwatch timer;
+    if (graph.hasVertexWeights()) {
+        solveWeighted(graph, size, options, stats, labels);
+        return;
+    }
+    std::string cover;
+    if (options.exact == "auto") {
+        cover = exactAuto(graph, size, options, stats, labels);
+    } else {
+        cover = graph.vcPolynomial();                               // Forests and bipartite graphs need no search
+    }
+    bool search = options.quality != "heuristic";
+    if (cover.empty() && search && options.exact == "clique") {
+        cover = graph.vcClique();
+    } else if (cover.empty() && search && options.exact == "sat") {
+        cover = graph.vcTreewidth(options.treewidth);               // Empty when the graph is too wide for the DP
+    }
+    if (!cover.empty() || search) {
+        std::cout << (cover.empty() ? graph.vcExact(size) : cover) << std::endl;
+        stats.engineMs["exact"] = timer.elapsedMs();
+    }
+
+    if (options.quality != "exact") {
+        timer.restart();
+        std::cout << graph.greedySolver1() << std::endl;
+        stats.engineMs["greedy1"] = timer.elapsedMs();
+
+        timer.restart();
+        std::cout << graph.greedySolver2() << std::endl;
+        stats.engineMs["greedy2"] = timer.elapsedMs();
+    }
+
+    if (options.approx) {                                   // Maximal matching, at most twice the minimum
+        timer.restart();
+        MatchingCover approx = matchingVertexCover(size, graph.edges(), options.threads);
+        approx.cover = improveHeuristicCover(buildAdjacency(size, graph.edges()), approx.cover, options, stats, "approx");
+        std::cout << coverFormatter("VC-APPROX", approx.cover, labels) << std::endl;
+        std::cout << "VC-APPROX-LB: " << approx.lowerBound << std::endl;
+        stats.engineMs["approx"] = timer.elapsedMs();
+        stats.counters["matching_lower_bound"] = approx.lowerBound;
+    }
+}
+
+/**
+ * Solves the graph in the --input file, or the one --generate describes. Graphs up to
+ * MATRIX_LIMIT vertices get every engine. A planted graph also prints its hidden minimum cover.
+ *
+ * @return the exit code
+ */
+int solveFile(const SolverOptions& options) {
+    GraphStats stats;
+    LoadedGraph loaded;
+    GeneratorSpec spec;
+    std::vector<int> planted;
+    Stopwatch timer;
+
+    if (!options.generate.empty()) {
+        if (!parseGeneratorSpec(options.generate, spec) || !generateGraph(spec, loaded, &planted)) {
+            return 1;
+        }
+    } else if (!loadGraph(options.input, formatFromName(options.format), options.threads, loaded)) {
+        return 1;
+    }
+    stats.id = 1;
+    stats.vertices = loaded.n;
+    stats.edges = loaded.edges.size();
+    stats.parseMs = timer.elapsedMs();
+    VertexOrder order = ORDER_NONE;
+    if (parseVertexOrder(options.reorder, order) && order != ORDER_NONE) {     // Covers keep the file ids through the labels
+        timer.restart();
+        relabelGraph(loaded, vertexOrder(buildAdjacency(loaded.n, loaded.edges), order));
+        stats.engineMs["reorder"] = timer.elapsedMs();
+    }
+
+    if (loaded.n <= MATRIX_LIMIT) {
+        Matrix graph(loaded.n, loaded.n);
+        graph.setMemoryBudget(options.memBudget);
+        graph.setImprove(options.improve);
+        graph.setThreads(options.threads);
+        graph.setCubeDepth(options.cubes);
+        graph.setLabels(loaded.labels);
+        graph.setStats(options.stats ? &stats : nullptr);
+        for (const auto& edge : loaded.edges) {
+            graph.set(edge[0], edge[1], 1);
+        }
+        for (size_t v = 0; v < loaded.weights.size(); v++) {
+            graph.setVertexWeight(v, loaded.weights[v]);
+        }
+        solveGraph(graph, loaded.n, options, stats, loaded.labels);
+    } else {
+        solveSparse(loaded, options, stats);
+    }
+    if (!options.generate.empty() && spec.family == FAMILY_PLANTED) {
+        std::cout << coverFormatter("VC-PLANTED", planted) << std::endl;
+    }
+
+    if (options.stats) {
+        emitStats(stats, options.statsPath);
+    }
+    return 0;
+}
+
+/**
+ * Runs the V, E, W, A and S commands read from a stream, solving each graph when its E command
+ * arrives.
+ *
+ * @param in the commands
+ * @param options the command line options
+ * @param graphCount the number of graphs solved before, to number the stats lines
+ */
+void processCommands(std::istream& in, const SolverOptions& options, int graphCount) {
+    GraphStats stats;
     std::string command;
-    int size;
+    int size = 0;
     bool graphExists = false;
     Matrix graph(1,1);
     std::vector<std::array<int,3>> eInput;
     std::array<int,2> sInput;
   
-    // read from stdin until EOF
+    // read from the stream until EOF
     std::string line;
-    while (!(getline(std::cin, line)).eof()) {
+    while (!(getline(in, line)).eof()) {
 
         // Code to process input lines
         command = commandFormatter(line);     // Checks for N, E, or S command
@@ -50,11 +246,19 @@ int main(const int argc, const char* argv[]) {
             if (size != -1) {
                 Matrix temp(size,size);                                 // Resize the graph as specified
                 graph = temp;
+                graph.setMemoryBudget(options.memBudget);
+                graph.setImprove(options.improve);
+                graph.setThreads(options.threads);
+                graph.setCubeDepth(options.cubes);
+                if (options.pathCache >= 0) {
+                    graph.setPathCacheBudget(options.pathCache);
+                }
                 graphExists = true;
             }
     
         } else if (command == "E") {                                  // If command is E
             
+            Stopwatch timer;
             eInput = eCommand(line);
             std::vector<std::array<int,3>> errorInput = { { -1, -1, -1 } };
             if (eInput != errorInput) {
@@ -62,24 +266,37 @@ int main(const int argc, const char* argv[]) {
                     graph.set(eInput[i][0]-1,eInput[i][1]-1,eInput[i][2]);  // Set edges in graph
                 }
 
+                stats = GraphStats();
+                stats.id = ++graphCount;
+                stats.vertices = size;
+                stats.edges = eInput.size();
+                stats.parseMs = timer.elapsedMs();
+                graph.setStats(options.stats ? &stats : nullptr);
+
                 //graph.print();
-                auto start = std::chrono::high_resolution_clock::now();
-                std::cout << graph.vcExact(size) << std::endl;
-                auto end = std::chrono::high_resolution_clock::now();
-                //std::cout << "Execution time: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " µs" << std::endl;
-
-                start = std::chrono::high_resolution_clock::now();
-                std::cout << graph.greedySolver1() << std::endl;
-                end = std::chrono::high_resolution_clock::now();
-                //std::cout << "Execution time: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " µs" << std::endl;
-
-                start = std::chrono::high_resolution_clock::now();
-                std::cout << graph.greedySolver2() << std::endl;
-                end = std::chrono::high_resolution_clock::now();
-                //std::cout << "Execution time: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " µs" << std::endl;
-                //std::cout << std::endl;
+                solveGraph(graph, size, options, stats);
+
+                if (options.stats) {
+                    emitStats(stats, options.statsPath);
+                }
             }
     
+        } else if (command == "W") {                                  // Vertex weights, must come before E
+
+            std::vector<std::array<int,2>> wInput = wCommand(line);
+            std::vector<std::array<int,2>> errorInput = { { -1, -1 } };
+            if (wInput != errorInput) {
+                for (size_t i = 0; i < wInput.size(); i++) {
+                    graph.setVertexWeight(wInput[i][0]-1, wInput[i][1]);
+                }
+            }
+
+        } else if (command == "A") {                                  // All pairs shortest paths for later S commands
+
+            if (aCommand(line)) {
+                graph.allPairsShortestPaths(options.threads);
+            }
+
         } else if (command == "S") {
             
             sInput = sCommand(line);
@@ -99,5 +316,25 @@ int main(const int argc, const char* argv[]) {
   
     }
 }
-  
- 
\ No newline at end of file
+
+int main(const int argc, const char* argv[]) {
+    // Test code. Replaced with your code
+    SolverOptions options = parseOptions(argc, argv);
+    if (!options.input.empty() || !options.generate.empty()) {
+        return solveFile(options);
+    }
+    if (options.workers > 0) {                          // Each graph on a worker process, a crash or limit loses only that graph
+        if (options.threads == 0) {
+            options.threads = std::max(1, threadCount(0) / options.workers);
+        }
+        WorkerLimits limits;
+        limits.rssBytes = options.workerRss;
+        limits.seconds = options.workerTime;
+        int failed = superviseWorkers(STDIN_FILENO, options.workers, limits, [&options](const std::string& job, int graphsBefore) {
+            std::istringstream in(job);
+            processCommands(in, options, graphsBefore);
+        });
+        return failed == 0 ? 0 : 1;
+    }
+    processCommands(std::cin, options, 0);
+}
@@ -0,0 +1,560 @@
+#include <algorithm>
+#include <vector>
+#include <array>
+#include <string>
+#include <atomic>
+#include <thread>
+
+#include "encoder.hpp"
+#include "matching.hpp"
+
+static const long long PARALLEL_ENCODE_LITERALS = 1 << 20;      // Smaller encodings are built on one thread
+static const long long CHUNKS_PER_THREAD = 16;                  // Rows vary in length, small chunks balance the threads
+static const int MAX_CUBE_DEPTH = 16;                           // At most 2^16 cubes per probe
+
+/**
+ * ClauseArena Class
+ * Enables building CNF without one heap allocation per clause.
+ */
+ClauseArena::ClauseArena() : starts(1, 0) {}
+
+/**
+ * Reserves space for the clauses and literals of an encoding.
+ *
+ * @param clauses the number of clauses
+ * @param lits the total number of literals over all clauses
+ */
+void ClauseArena::reserve(long long clauses, long long lits) {
+    starts.reserve(clauses + 1);
+    literals.reserve(lits);
+}
+
+/**
+ * Sizes the arena to exactly the given clauses and literals, to be filled by Writers.
+ *
+ * @param clauses the number of clauses
+ * @param lits the total number of literals over all clauses
+ */
+void ClauseArena::allocate(long long clauses, long long lits) {
+    starts.resize(clauses + 1);
+    literals.resize(lits);
+    starts[0] = 0;
+}
+
+/**
+ * Starts writing at a clause whose first literal lands at a given offset.
+ *
+ * @param arena the arena, sized by allocate
+ * @param clause the index of the first clause written
+ * @param lit the offset of its first literal
+ */
+ClauseArena::Writer::Writer(ClauseArena& arena, size_t clause, size_t lit)
+    : literal(arena.literals.data() + lit), start(arena.starts.data() + clause), offset(lit) {}
+
+/**
+ * Removes all clauses while keeping the allocated buffers.
+ */
+void ClauseArena::clear() {
+    literals.clear();
+    starts.assign(1, 0);
+}
+
+/**
+ * Appends a literal to the clause currently being built.
+ *
+ * @param lit the DIMACS literal
+ */
+void ClauseArena::push(int lit) {
+    literals.push_back(lit);
+}
+
+/**
+ * Ends the clause currently being built.
+ */
+void ClauseArena::close() {
+    starts.push_back(literals.size());
+}
+
+void ClauseArena::add(int a) {
+    literals.push_back(a);
+    close();
+}
+
+void ClauseArena::add(int a, int b) {
+    literals.push_back(a);
+    literals.push_back(b);
+    close();
+}
+
+void ClauseArena::add(int a, int b, int c) {
+    literals.push_back(a);
+    literals.push_back(b);
+    literals.push_back(c);
+    close();
+}
+
+size_t ClauseArena::size() const {
+    return starts.size() - 1;
+}
+
+size_t ClauseArena::literalCount() const {
+    return literals.size();
+}
+
+size_t ClauseArena::length(size_t c) const {
+    return starts[c+1] - starts[c];
+}
+
+const int* ClauseArena::clause(size_t c) const {
+    return literals.data() + starts[c];
+}
+
+/**
+ * Computes the exact number of variables, clauses and literals of an encoding and estimates
+ * the memory it needs. The estimate counts the arena (4 bytes per literal, 8 per clause offset)
+ * and a solver copy (4 bytes per literal, a 4 byte header and two 8 byte watchers per clause,
+ * about 64 bytes of per-variable state).
+ *
+ * @param encoding the encoding
+ * @param n the number of vertices
+ * @param m the number of edges
+ * @param k the size of the cover
+ * @return the size of the encoding
+ */
+EncodingSize encodingSize(Encoding encoding, int n, size_t m, int k) {
+    EncodingSize size = { 0, 0, 0, 0 };
+    long long N = n, M = m, K = k;
+
+    if (encoding == ENCODING_POSITION) {
+        size.vars = N * K;
+        size.clauses = K + N * K * (K - 1) / 2 + K * N * (N - 1) / 2 + M;
+        size.literals = K * N + N * K * (K - 1) + K * N * (N - 1) + 2 * K * M;
+    } else if (encoding == ENCODING_COUNTER) {
+        size.vars = N;
+        size.clauses = M;
+        size.literals = 2 * M;
+        if (K == 0) {                                                   // Every vertex is forced out
+            size.clauses += N;
+            size.literals += N;
+        } else if (K < N) {                                             // Sequential counter, n >= 2 here
+            size.vars += (N - 1) * K;
+            size.clauses += K + (N - 2) * (2 * K + 1) + 1;
+            size.literals += (K + 1) + (N - 2) * (5 * K + 1) + 2;
+        }
+    }
+
+    size.bytes = 8 * size.literals + 28 * size.clauses + 64 * size.vars;
+    return size;
+}
+
+/**
+ * Picks the position encoding when it fits the memory budget, the counter encoding otherwise.
+ *
+ * @param n the number of vertices
+ * @param m the number of edges
+ * @param k the size of the cover
+ * @param budget the memory budget in bytes, 0 for no limit
+ * @return the encoding to use, ENCODING_NONE if neither fits
+ */
+Encoding chooseEncoding(int n, size_t m, int k, long long budget) {
+    if (budget <= 0 || encodingSize(ENCODING_POSITION, n, m, k).bytes <= budget) {
+        return ENCODING_POSITION;
+    }
+    if (encodingSize(ENCODING_COUNTER, n, m, k).bytes <= budget) {
+        return ENCODING_COUNTER;
+    }
+    return ENCODING_NONE;
+}
+
+/**
+ * Returns the name of an encoding for logs and statistics.
+ */
+std::string encodingName(Encoding encoding) {
+    switch (encoding) {
+        case ENCODING_POSITION: return "position";
+        case ENCODING_COUNTER: return "counter";
+        default: return "none";
+    }
+}
+
+/**
+ * PositionLayout Struct
+ * Splits the position encoding into rows: one per position for clause 1, one per vertex for
+ * clause 2, one per position and first vertex for clause 3 and one per edge for clause 4. The
+ * arena offset of every row has a closed form, so any run of rows can be written on its own.
+ */
+struct PositionLayout {
+    long long n, k, m;
+    long long pairs2, pairs3;                       // Clauses of a clause 2 row and of a position's clause 3 rows
+    long long clause2, clause3, clause4;            // First clause of each group
+    long long rows2, rows3, rows4, rows;            // First row of each group, and the row count
+
+    PositionLayout(int vertices, size_t edges, int size)
+        : n(vertices), k(size), m(edges), pairs2(k * (k - 1) / 2), pairs3(n * (n - 1) / 2),
+          clause2(k), clause3(clause2 + n * pairs2), clause4(clause3 + k * pairs3),
+          rows2(k), rows3(rows2 + n), rows4(rows3 + k * n), rows(rows4 + m) {}
+
+    /**
+     * Returns the first clause of row r and stores the offset of its first literal in lit.
+     */
+    long long start(long long r, long long& lit) const {
+        if (r < rows2) {
+            lit = r * n;
+            return r;
+        } else if (r < rows3) {
+            lit = clause2 * n + 2 * (r - rows2) * pairs2;
+            return clause2 + (r - rows2) * pairs2;
+        } else if (r < rows4) {
+            long long p = (r - rows3) % n;
+            long long before = (r - rows3) / n * pairs3 + p * (n - 1) - p * (p - 1) / 2;
+            lit = clause2 * n + 2 * (clause3 - clause2) + 2 * before;
+            return clause3 + before;
+        }
+        lit = clause2 * n + 2 * (clause4 - clause2) + 2 * k * (r - rows4);
+        return clause4 + (r - rows4);
+    }
+};
+
+/**
+ * Writes rows [begin, end) of the position encoding to out, an arena or a Writer.
+ */
+template <typename Sink>
+static void writePositionRows(const PositionLayout& layout, const std::vector<std::array<int,2>>& edges, long long begin, long long end, Sink& out) {
+    int n = layout.n, k = layout.k;
+    // x[i][j] where i is position and j is vertex
+    auto x = [n](int i, int j) { return i * n + j + 1; };
+
+    for (long long r = begin; r < end; r++) {
+        if (r < layout.rows2) {                                         // CLAUSE 1: One vertex in each position
+            int i = r;
+            for (int j = 0; j < n; j++) {
+                out.push(x(i,j));
+            }
+            out.close();
+        } else if (r < layout.rows3) {                                  // CLAUSE 2: Vertex cannot be in both position p and q
+            int m = r - layout.rows2;
+            for (int q = 0; q < k; q++) {
+                for (int p = q+1; p < k; p++) {
+                    out.add(-x(p,m), -x(q,m));
+                }
+            }
+        } else if (r < layout.rows4) {                                  // CLAUSE 3: Position m can only have one vertex, p or q
+            int m = (r - layout.rows3) / n;
+            int p = (r - layout.rows3) % n;
+            for (int q = p+1; q < n; q++) {
+                out.add(-x(m,p), -x(m,q));
+            }
+        } else {                                                        // CLAUSE 4: Every edge has an endpoint in some position
+            const std::array<int,2>& edge = edges[r - layout.rows4];
+            for (int i = 0; i < k; i++) {
+                out.push(x(i,edge[0]));
+                out.push(x(i,edge[1]));
+            }
+            out.close();
+        }
+    }
+}
+
+/**
+ * Builds the clauses of the position based reduction: k positions each holding exactly one
+ * vertex, no vertex in two positions and every edge covered by some position.
+ *
+ * Large encodings are split into chunks of rows that the threads take in turn, each writing
+ * its chunk in place. The arena holds the same clauses in the same order for any thread count.
+ */
+static void encodePosition(int n, const std::vector<std::array<int,2>>& edges, int k, ClauseArena& arena, int threads) {
+    PositionLayout layout(n, edges.size(), k);
+    EncodingSize size = encodingSize(ENCODING_POSITION, n, edges.size(), k);
+    long long workers = 1;
+    if (size.literals >= PARALLEL_ENCODE_LITERALS) {
+        workers = std::min<long long>(threadCount(threads), layout.rows);
+    }
+    if (workers <= 1) {                                                 // Appending skips zeroing the buffers first
+        arena.reserve(size.clauses, size.literals);
+        writePositionRows(layout, edges, 0, layout.rows, arena);
+        return;
+    }
+
+    arena.allocate(size.clauses, size.literals);
+    long long chunk = std::max<long long>(1, layout.rows / (workers * CHUNKS_PER_THREAD));
+    std::atomic<long long> next(0);
+    auto work = [&]() {
+        for (long long begin = next.fetch_add(chunk); begin < layout.rows; begin = next.fetch_add(chunk)) {
+            long long lit = 0;
+            long long clause = layout.start(begin, lit);
+            ClauseArena::Writer out(arena, clause, lit);
+            writePositionRows(layout, edges, begin, std::min(layout.rows, begin + chunk), out);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (long long t = 1; t < workers; t++) {
+        pool.push_back(std::thread(work));
+    }
+    work();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+/**
+ * Builds the clauses of the sequential counter reduction (Sinz 2005): x[j] marks vertex j as
+ * part of the cover, s[j][l] states that at least l of x[1..j] are true, and s never exceeds k.
+ */
+static void encodeCounter(int n, const std::vector<std::array<int,2>>& edges, int k, ClauseArena& arena) {
+    auto x = [](int j) { return j; };                                   // 1 <= j <= n
+    auto s = [n,k](int j, int l) { return n + (j-1)*k + l; };           // 1 <= j < n, 1 <= l <= k
+
+    if (k == 0) {
+        for (int j = 1; j <= n; j++) {
+            arena.add(-x(j));
+        }
+    } else if (k < n) {
+        arena.add(-x(1), s(1,1));
+        for (int l = 2; l <= k; l++) {
+            arena.add(-s(1,l));
+        }
+
+        for (int j = 2; j < n; j++) {
+            arena.add(-x(j), s(j,1));
+            arena.add(-s(j-1,1), s(j,1));
+            for (int l = 2; l <= k; l++) {
+                arena.add(-x(j), -s(j-1,l-1), s(j,l));
+                arena.add(-s(j-1,l), s(j,l));
+            }
+            arena.add(-x(j), -s(j-1,k));
+        }
+
+        arena.add(-x(n), -s(n-1,k));
+    }
+
+    for (size_t e = 0; e < edges.size(); e++) {                         // Every edge has an endpoint in the cover
+        arena.add(x(edges[e][0]+1), x(edges[e][1]+1));
+    }
+}
+
+/**
+ * Encodes "the graph has a vertex cover of size at most k" into the arena, which is sized
+ * up front so that no reallocation happens while clauses are generated.
+ *
+ * @param encoding the encoding, ENCODING_NONE leaves the arena empty
+ * @param n the number of vertices
+ * @param edges the edge list, vertices numbered from 0
+ * @param k the size of the cover
+ * @param arena the arena to fill, cleared first
+ * @param threads the threads generating position clauses, 0 for one per hardware thread
+ */
+void encode(Encoding encoding, int n, const std::vector<std::array<int,2>>& edges, int k, ClauseArena& arena, int threads) {
+    arena.clear();
+
+    if (encoding == ENCODING_POSITION) {
+        encodePosition(n, edges, k, arena, threads);
+    } else if (encoding == ENCODING_COUNTER) {
+        EncodingSize size = encodingSize(encoding, n, edges.size(), k);
+        arena.reserve(size.clauses, size.literals);
+        encodeCounter(n, edges, k, arena);
+    }
+}
+
+/**
+ * Reads the vertex cover out of a satisfying assignment.
+ *
+ * @param encoding the encoding that was solved
+ * @param n the number of vertices
+ * @param k the size of the cover
+ * @param isTrue returns the value of a DIMACS variable in the model
+ * @return the sorted cover, vertices numbered from 0
+ */
+std::vector<int> decodeCover(Encoding encoding, int n, int k, const std::function<bool(int)>& isTrue) {
+    std::vector<int> cover;
+
+    if (encoding == ENCODING_POSITION) {
+        for (int i = 0; i < k; i++) {
+            for (int j = 0; j < n; j++) {
+                if (isTrue(i * n + j + 1)) {
+                    cover.push_back(j);
+                }
+            }
+        }
+    } else if (encoding == ENCODING_COUNTER) {
+        for (int j = 0; j < n; j++) {
+            if (isTrue(j + 1)) {
+                cover.push_back(j);
+            }
+        }
+    }
+
+    std::sort(cover.begin(), cover.end());
+    return cover;
+}
+
+/**
+ * Returns the variables a solver should decide true first to land near a cover of size k, built
+ * from a larger known cover. The vertices that alone cover the fewest edges are dropped, so the
+ * hint leaves few edges uncovered; every variable not returned is best decided false.
+ *
+ * @param encoding the encoding of the probe
+ * @param n the number of vertices
+ * @param edges the edge list, vertices numbered from 0
+ * @param k the size of the cover
+ * @param cover the best known cover, vertices numbered from 0
+ * @return the DIMACS variables to decide true
+ */
+std::vector<int> phaseHint(Encoding encoding, int n, const std::vector<std::array<int,2>>& edges, int k, const std::vector<int>& cover) {
+    std::vector<char> inCover(n, 0);
+    std::vector<int> alone(n, 0);                                       // Edges only this cover vertex covers
+    for (int v : cover) {
+        inCover[v] = 1;
+    }
+    for (size_t e = 0; e < edges.size(); e++) {
+        int u = edges[e][0], v = edges[e][1];
+        if (inCover[u] != inCover[v]) {
+            alone[inCover[u] ? u : v]++;
+        }
+    }
+
+    std::vector<int> kept = cover;
+    std::stable_sort(kept.begin(), kept.end(), [&alone](int a, int b) { return alone[a] > alone[b]; });
+    kept.resize(std::min<size_t>(kept.size(), std::max(k, 0)));
+
+    std::vector<int> hint;
+    if (encoding == ENCODING_POSITION) {
+        for (size_t i = 0; i < kept.size(); i++) {                      // Kept vertex i in position i
+            hint.push_back(i * n + kept[i] + 1);
+        }
+    } else if (encoding == ENCODING_COUNTER) {
+        std::fill(inCover.begin(), inCover.end(), 0);
+        for (int v : kept) {
+            inCover[v] = 1;
+            hint.push_back(v + 1);
+        }
+        if (k > 0 && k < n) {                                           // Counter values consistent with the kept vertices
+            int count = 0;
+            for (int j = 1; j < n; j++) {
+                count += inCover[j-1];
+                for (int l = 1; l <= std::min(count, k); l++) {
+                    hint.push_back(n + (j-1)*k + l);
+                }
+            }
+        }
+    }
+    return hint;
+}
+
+/**
+ * Splits a probe into cubes for cube-and-conquer by deciding, for each of the depth highest degree
+ * vertices, whether it is in the cover. A vertex left out forces its neighbors in, so cubes that
+ * leave an edge uncovered or force more than k vertices in are refuted here and not returned.
+ * Cubes with more vertices in come first, as high degree vertices are usually in small covers.
+ *
+ * In the position encoding the vertices in the cube take positions 0, 1, ... in increasing order,
+ * which loses no cover since positions are interchangeable, and a vertex out is false at every
+ * position. Together the cubes cover every model of the probe.
+ *
+ * @param encoding the encoding of the probe
+ * @param n the number of vertices
+ * @param edges the edge list, vertices numbered from 0
+ * @param k the size of the cover
+ * @param depth the number of vertices decided, at most 16
+ * @return the cubes, each a list of DIMACS literals
+ */
+std::vector<std::vector<int>> splitCubes(Encoding encoding, int n, const std::vector<std::array<int,2>>& edges, int k, int depth) {
+    enum { FREE, IN, OUT };
+    std::vector<std::vector<int>> cubes;
+    std::vector<int> degree(n, 0);
+    for (size_t e = 0; e < edges.size(); e++) {
+        degree[edges[e][0]]++;
+        degree[edges[e][1]]++;
+    }
+
+    depth = std::max(0, std::min(std::min(depth, n), MAX_CUBE_DEPTH));
+    std::vector<int> split(n);
+    for (int v = 0; v < n; v++) {
+        split[v] = v;
+    }
+    std::partial_sort(split.begin(), split.begin() + depth, split.end(), [&degree](int a, int b) {
+        return degree[a] > degree[b] || (degree[a] == degree[b] && a < b);
+    });
+    split.resize(depth);
+
+    std::vector<int> index(n, -1);
+    for (int i = 0; i < depth; i++) {
+        index[split[i]] = i;
+    }
+    std::vector<std::vector<int>> neighbors(depth);
+    for (size_t e = 0; e < edges.size(); e++) {
+        int u = edges[e][0], v = edges[e][1];
+        if (index[u] >= 0) {
+            neighbors[index[u]].push_back(v);
+        }
+        if (index[v] >= 0) {
+            neighbors[index[v]].push_back(u);
+        }
+    }
+
+    std::vector<unsigned> masks(1u << depth);
+    for (unsigned mask = 0; mask < masks.size(); mask++) {
+        masks[mask] = mask;
+    }
+    std::stable_sort(masks.begin(), masks.end(), [](unsigned a, unsigned b) { return __builtin_popcount(a) > __builtin_popcount(b); });
+
+    std::vector<char> state(n, FREE);
+    std::vector<int> in;
+    std::vector<int> out;
+    for (unsigned mask : masks) {
+        in.clear();
+        out.clear();
+        for (int i = 0; i < depth; i++) {
+            if ((mask >> i) & 1) {
+                state[split[i]] = IN;
+                in.push_back(split[i]);
+            } else {
+                state[split[i]] = OUT;
+                out.push_back(split[i]);
+            }
+        }
+        bool feasible = true;
+        for (size_t i = 0; i < out.size() && feasible; i++) {       // Neighbors of a vertex out are in
+            for (int u : neighbors[index[out[i]]]) {
+                if (state[u] == OUT) {                              // Uncovered edge, or a self loop
+                    feasible = false;
+                    break;
+                } else if (state[u] == FREE) {
+                    state[u] = IN;
+                    in.push_back(u);
+                }
+            }
+        }
+        feasible = feasible && (int)in.size() <= k;
+
+        if (feasible) {
+            std::vector<int> cube;
+            if (encoding == ENCODING_POSITION) {
+                std::sort(in.begin(), in.end());
+                for (size_t i = 0; i < in.size(); i++) {
+                    cube.push_back(i * n + in[i] + 1);
+                }
+                for (int v : out) {
+                    for (int i = 0; i < k; i++) {
+                        cube.push_back(-(i * n + v + 1));
+                    }
+                }
+            } else if (encoding == ENCODING_COUNTER) {
+                for (int v : in) {
+                    cube.push_back(v + 1);
+                }
+                for (int v : out) {
+                    cube.push_back(-(v + 1));
+                }
+            }
+            cubes.push_back(cube);
+        }
+        for (int v : in) {
+            state[v] = FREE;
+        }
+        for (int v : out) {
+            state[v] = FREE;
+        }
+    }
+    return cubes;
+}
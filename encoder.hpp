@@ -0,0 +1,79 @@
+#ifndef ENCODER_HPP
+#define ENCODER_HPP
+
+#include <vector>
+#include <array>
+#include <string>
+#include <functional>
+#include <cstddef>
+
+// CNF encodings of "the graph has a vertex cover of size at most k"
+enum Encoding {
+    ENCODING_NONE,                                  // Refused, does not fit the memory budget
+    ENCODING_POSITION,                              // x[i][j]: vertex j is the i-th member of the cover, O(k n^2 + n k^2) clauses
+    ENCODING_COUNTER                                // x[j] plus a sequential counter over the x[j], O(n k) clauses
+};
+
+// Exact size of an encoding, computed before anything is allocated
+struct EncodingSize {
+    long long vars;
+    long long clauses;
+    long long literals;
+    long long bytes;                                // Estimated peak memory of the arena plus the solver's copy
+};
+
+/**
+ * ClauseArena Class
+ * Stores all clauses of an encoding in one contiguous literal buffer. Literals use
+ * DIMACS numbering: variables start at 1 and negative values are negated literals.
+ */
+class ClauseArena {
+    std::vector<int> literals;
+    std::vector<size_t> starts;                     // starts[c] is the offset of clause c, with a trailing sentinel
+
+public:
+    /**
+     * Writer Class
+     * Writes a run of clauses whose offsets are known in advance into an arena sized by allocate.
+     * Writers over disjoint runs may fill the arena from several threads at once.
+     */
+    class Writer {
+        int* literal;
+        size_t* start;
+        size_t offset;
+
+    public:
+        Writer(ClauseArena& arena, size_t clause, size_t lit);
+
+        void push(int lit) { *literal++ = lit; offset++; }
+        void close() { *++start = offset; }
+        void add(int a, int b) { push(a); push(b); close(); }
+    };
+
+    ClauseArena();
+
+    void reserve(long long clauses, long long lits);
+    void allocate(long long clauses, long long lits);
+    void clear();
+    void push(int lit);
+    void close();
+    void add(int a);
+    void add(int a, int b);
+    void add(int a, int b, int c);
+
+    size_t size() const;
+    size_t literalCount() const;
+    size_t length(size_t c) const;
+    const int* clause(size_t c) const;
+};
+
+EncodingSize encodingSize(Encoding encoding, int n, size_t m, int k);
+Encoding chooseEncoding(int n, size_t m, int k, long long budget);
+std::string encodingName(Encoding encoding);
+void encode(Encoding encoding, int n, const std::vector<std::array<int,2>>& edges, int k, ClauseArena& arena, int threads = 1);
+std::vector<int> decodeCover(Encoding encoding, int n, int k, const std::function<bool(int)>& isTrue);
+std::vector<std::vector<int>> splitCubes(Encoding encoding, int n, const std::vector<std::array<int,2>>& edges, int k, int depth);
+std::vector<int> phaseHint(Encoding encoding, int n, const std::vector<std::array<int,2>>& edges, int k, const std::vector<int>& cover);
+
+
+#endif
@@ -15,8 +15,8 @@
  * @return the character command (N,E,S) as a string
  */
 std::string commandFormatter(std::string input) {
-    std::regex commandPattern(R"(^\s*(V|E|S|G)\s*)");                                 // Matches N, E, or S and optional whitespace
-    std::regex errorPattern(R"([^NESG0-9,-{}\(\)\s]+)");                             // Matches all characters that are not in {(<int>,<int>,<int>)},
+    std::regex commandPattern(R"(^\s*(V|E|S|G|W|A)\s*)");                             // Matches N, E, or S and optional whitespace
+    std::regex errorPattern(R"([^NESGWA0-9,-{}\(\)\s]+)");                            // Matches all characters that are not in {(<int>,<int>,<int>)},
     std::smatch s;
     std::string command;
     
@@ -122,3 +122,89 @@ std::array<int,2> sCommand(std::string input) {
     }
 }
 
+/**
+ * Check the specific format of W command and outputs errors for incorrect format.
+ * 
+ * @param input the user input, ex. W {<1,5>,<2,3>}
+ * @return the vertices and their weights
+ */
+std::vector<std::array<int,2>> wCommand(std::string input) {
+    std::regex WPattern(R"(\s*W\s+\{\s*(<\s*-?\d+\s*,\s*-?\d+\s*>\s*,\s*)*<\s*-?\d+\s*,\s*-?\d+\s*>\s*\}\s*)");   // Matches W {<int>,<int>} with one or more pairs
+    std::regex weightPattern(R"(<\s*(-?\d+)\s*,\s*(-?\d+)\s*>)");
+    std::smatch s;
+    std::vector<std::array<int,2>> returnList;
+
+    if (!std::regex_match(input, s, WPattern)) {                                   // Checks W {<int>,<int>} format
+        std::cerr << "Error: Invalid W command format. Input should take the form W {<vertex>,<weight>}.\n";
+        return { { -1, -1 } };
+    }
+
+    std::sregex_iterator weights(input.begin(), input.end(), weightPattern);
+    std::sregex_iterator weightsEnd;
+    for (; weights != weightsEnd; ++weights) {
+        int v = stoi(weights->str(1));
+        int w = stoi(weights->str(2));
+        if (v < 1 || w < 0) {                                                       // Checks vertex and weight are positive
+            std::cerr << "Error: Invalid W command format. Vertices start at 1 and weights cannot be negative.\n";
+            return { { -1, -1 } };
+        }
+        returnList.push_back( {v,w} );
+    }
+
+    return returnList;
+}
+
+/**
+ * Check the specific format of A command, which takes no arguments.
+ * 
+ * @param input the user input
+ * @return true if the command is valid
+ */
+bool aCommand(std::string input) {
+    std::regex APattern(R"(\s*A\s*)");                                                // Matches A and optional whitespaces
+    if (!std::regex_match(input, APattern)) {
+        std::cerr << "Error: Invalid A command format. Input should take the form A.\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Formats a vertex cover as an output line, ex. VC-APPROX: 1 3 4 (3)
+ * 
+ * @param name the name of the solver
+ * @param vertexCover the vertex cover, vertices numbered from 0
+ * @param labels the printed name of each vertex, empty to number them from 1
+ * @return the sorted cover with vertices numbered from 1 and its size
+ */
+std::string coverFormatter(std::string name, std::vector<int> vertexCover, const std::vector<int>& labels) {
+    std::string cover = name + ": ";
+
+    for (size_t i = 0; i < vertexCover.size(); i++) {       // Sorted by printed name, vertices may be reordered
+        vertexCover[i] = labels.empty() ? vertexCover[i]+1 : labels[vertexCover[i]];
+    }
+    std::sort(vertexCover.begin(), vertexCover.end());
+    for (size_t i = 0; i < vertexCover.size(); i++) {
+        cover.append(std::to_string(vertexCover[i]) + " ");
+    }
+    cover.append("(" + std::to_string(vertexCover.size()) + ")");
+    return cover;
+}
+
+/**
+ * Formats a weighted vertex cover as an output line, ex. VC-WEIGHTED-EXACT: 1 3 (2) [7]
+ * 
+ * @param name the name of the solver
+ * @param vertexCover the vertex cover, vertices numbered from 0
+ * @param weights the weight of each vertex
+ * @param labels the printed name of each vertex, empty to number them from 1
+ * @return the cover line followed by its total weight in brackets
+ */
+std::string weightedCoverFormatter(std::string name, std::vector<int> vertexCover, const std::vector<long long>& weights,
+                                   const std::vector<int>& labels) {
+    long long total = 0;
+    for (int v : vertexCover) {
+        total += weights[v];
+    }
+    return coverFormatter(name, vertexCover, labels) + " [" + std::to_string(total) + "]";
+}
@@ -1,6 +1,7 @@
 #ifndef FORMATTER_HPP
 #define FORMATTER_HPP
 
+#include <string>
 #include <vector>
 #include <array>
 
@@ -8,6 +9,11 @@ std::string commandFormatter(std::string input);
 int nCommand(std::string input);
 std::vector<std::array<int,3>> eCommand(std::string input);
 std::array<int,2> sCommand(std::string input);
+std::vector<std::array<int,2>> wCommand(std::string input);
+bool aCommand(std::string input);
+std::string coverFormatter(std::string name, std::vector<int> vertexCover, const std::vector<int>& labels = std::vector<int>());
+std::string weightedCoverFormatter(std::string name, std::vector<int> vertexCover, const std::vector<long long>& weights,
+                                   const std::vector<int>& labels = std::vector<int>());
 
 
 #endif
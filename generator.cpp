@@ -0,0 +1,451 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <unordered_set>
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <cstdlib>
+
+#include "generator.hpp"
+
+/**
+ * SeededRandom Class
+ * Every generator draws from one of these, seeded by the spec.
+ *
+ * @param seed the seed
+ */
+SeededRandom::SeededRandom(uint64_t seed) : state(seed) {}
+
+uint64_t SeededRandom::next() {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Returns a uniform integer in [0, bound), rejecting the values that would bias the modulo.
+ */
+uint64_t SeededRandom::below(uint64_t bound) {
+    uint64_t threshold = (0 - bound) % bound;
+    for (;;) {
+        uint64_t r = next();
+        if (r >= threshold) {
+            return r % bound;
+        }
+    }
+}
+
+/**
+ * Returns a uniform double in [0, 1) from the top 53 bits.
+ */
+double SeededRandom::unit() {
+    return (next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Returns how many pairs to pass over before the next edge when each pair is an edge with
+ * probability p, so sparse graphs cost time in their edges rather than in their pairs.
+ */
+static long long skipLength(SeededRandom& random, double logMiss) {
+    double skip = std::floor(std::log(1.0 - random.unit()) / logMiss);
+    return skip < (double)(LLONG_MAX / 4) ? (long long)skip : LLONG_MAX / 4;
+}
+
+/**
+ * Calls visit(w, v) for each pair w < v < n independently with probability p, walking the pairs
+ * row by row with geometric skips (Batagelj and Brandes).
+ */
+template <typename Visit>
+static void randomPairs(SeededRandom& random, int n, double p, Visit visit) {
+    if (p <= 0) {
+        return;
+    }
+    if (p >= 1) {
+        for (int v = 1; v < n; v++) {
+            for (int w = 0; w < v; w++) {
+                visit(w, v);
+            }
+        }
+        return;
+    }
+    double logMiss = std::log(1.0 - p);
+    long long v = 1, w = -1;
+    while (v < n) {
+        w += 1 + skipLength(random, logMiss);
+        while (w >= v && v < n) {
+            w -= v;
+            v++;
+        }
+        if (v < n) {
+            visit((int)w, (int)v);
+        }
+    }
+}
+
+/**
+ * Calls visit(row, col) for each cell of a rows x cols grid independently with probability p.
+ */
+template <typename Visit>
+static void randomCells(SeededRandom& random, int rows, int cols, double p, Visit visit) {
+    if (p <= 0 || rows == 0 || cols == 0) {
+        return;
+    }
+    long long total = (long long)rows * cols;
+    double logMiss = p < 1 ? std::log(1.0 - p) : 0;
+    for (long long cell = (p < 1 ? skipLength(random, logMiss) : 0); cell < total;
+         cell += 1 + (p < 1 ? skipLength(random, logMiss) : 0)) {
+        visit((int)(cell / cols), (int)(cell % cols));
+    }
+}
+
+/**
+ * Appends edge u-v with the smaller vertex first.
+ */
+static void addEdge(LoadedGraph& graph, int u, int v) {
+    graph.edges.push_back({std::min(u, v), std::max(u, v)});
+}
+
+/**
+ * G(n,m): m distinct pairs drawn uniformly. Above half of all pairs the missing pairs are drawn
+ * instead, so rejection sampling never stalls on a nearly complete graph.
+ */
+static void generateGnm(const GeneratorSpec& spec, SeededRandom& random, LoadedGraph& graph) {
+    long long pairs = (long long)spec.n * (spec.n - 1) / 2;
+    bool complement = spec.m > pairs / 2;
+    long long draws = complement ? pairs - spec.m : spec.m;
+    std::unordered_set<long long> drawn;
+    drawn.reserve(draws);
+
+    while ((long long)drawn.size() < draws) {
+        int u = random.below(spec.n);
+        int v = random.below(spec.n);
+        if (u == v) {
+            continue;
+        }
+        long long key = (long long)std::min(u, v) * spec.n + std::max(u, v);
+        if (drawn.insert(key).second && !complement) {
+            addEdge(graph, u, v);
+        }
+    }
+
+    if (complement) {
+        graph.edges.reserve(spec.m);
+        for (int u = 0; u < spec.n; u++) {
+            for (int v = u + 1; v < spec.n; v++) {
+                if (drawn.count((long long)u * spec.n + v) == 0) {
+                    graph.edges.push_back({u, v});
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Barabasi-Albert: starts from a clique on m + 1 vertices, then joins each new vertex to m
+ * distinct earlier vertices chosen with probability proportional to their degree. Every edge
+ * lists both endpoints in ends, so a uniform draw from ends is a degree weighted draw.
+ */
+static void generateBarabasiAlbert(const GeneratorSpec& spec, SeededRandom& random, LoadedGraph& graph) {
+    int core = (int)std::min<long long>(spec.n, spec.m + 1);
+    std::vector<int> ends;
+    std::vector<int> chosen;
+    ends.reserve(2 * spec.m * spec.n);
+
+    for (int v = 1; v < core; v++) {
+        for (int u = 0; u < v; u++) {
+            addEdge(graph, u, v);
+            ends.push_back(u);
+            ends.push_back(v);
+        }
+    }
+    for (int v = core; v < spec.n; v++) {
+        chosen.clear();
+        while ((long long)chosen.size() < spec.m) {
+            int target = ends[random.below(ends.size())];
+            if (std::find(chosen.begin(), chosen.end(), target) == chosen.end()) {
+                chosen.push_back(target);
+            }
+        }
+        for (int target : chosen) {
+            addEdge(graph, target, v);
+            ends.push_back(target);
+            ends.push_back(v);
+        }
+    }
+}
+
+/**
+ * Planted cover: a random set C of k vertices, a perfect matching from C into the other vertices
+ * and every other pair touching C with probability p. No edge joins two vertices outside C, so
+ * C is a cover, and the k matching edges need k distinct cover vertices, so no cover is smaller.
+ */
+static void generatePlanted(const GeneratorSpec& spec, SeededRandom& random, LoadedGraph& graph, std::vector<int>* planted) {
+    std::vector<int> order(spec.n);
+    for (int v = 0; v < spec.n; v++) {
+        order[v] = v;
+    }
+    for (int i = spec.n - 1; i > 0; i--) {                          // Fisher-Yates shuffle
+        std::swap(order[i], order[random.below(i + 1)]);
+    }
+
+    int k = spec.k;
+    for (int i = 0; i < k; i++) {
+        addEdge(graph, order[i], order[k + i]);
+    }
+    randomPairs(random, k, spec.p, [&](int a, int b) {
+        addEdge(graph, order[a], order[b]);
+    });
+    randomCells(random, k, spec.n - k, spec.p, [&](int a, int b) {
+        if (a != b) {                                               // The matching edge is already there
+            addEdge(graph, order[a], order[k + b]);
+        }
+    });
+
+    if (planted != nullptr) {
+        planted->assign(order.begin(), order.begin() + k);
+        std::sort(planted->begin(), planted->end());
+    }
+}
+
+/**
+ * Checks the parameters of a spec against its family.
+ */
+static bool validSpec(const GeneratorSpec& spec) {
+    if (spec.n < 0) {
+        std::cerr << "Error: Generated graphs need a non-negative number of vertices.\n";
+        return false;
+    }
+    if (spec.p < 0 || spec.p > 1) {
+        std::cerr << "Error: Edge probability " << spec.p << " is not between 0 and 1.\n";
+        return false;
+    }
+    switch (spec.family) {
+    case FAMILY_GNM:
+        if (spec.m < 0 || spec.m > (long long)spec.n * (spec.n - 1) / 2) {
+            std::cerr << "Error: " << spec.n << " vertices cannot hold " << spec.m << " edges.\n";
+            return false;
+        }
+        break;
+    case FAMILY_BA:
+        if (spec.m < 1 || (spec.n > 0 && spec.m >= spec.n)) {
+            std::cerr << "Error: Barabasi-Albert graphs need 1 <= m < n.\n";
+            return false;
+        }
+        break;
+    case FAMILY_GRID:
+        if (spec.rows < 0 || spec.cols < 0 || (long long)spec.rows * spec.cols != spec.n) {
+            std::cerr << "Error: Grids need non-negative rows and cols with rows * cols vertices.\n";
+            return false;
+        }
+        break;
+    case FAMILY_BIPARTITE:
+        if (spec.left < 0 || spec.left > spec.n) {
+            std::cerr << "Error: Bipartite graphs need non-negative left and right sides.\n";
+            return false;
+        }
+        break;
+    case FAMILY_PLANTED:
+        if (spec.k < 0 || 2LL * spec.k > spec.n) {
+            std::cerr << "Error: A planted cover of size k needs at least 2k vertices.\n";
+            return false;
+        }
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+/**
+ * Generates a graph into the same representation the file loader produces.
+ *
+ * @param spec the family and its parameters
+ * @param graph receives the graph, vertices numbered from 0
+ * @param planted receives the hidden minimum cover of a planted graph, may be nullptr
+ * @return false and prints an error if the parameters are invalid
+ */
+bool generateGraph(const GeneratorSpec& spec, LoadedGraph& graph, std::vector<int>* planted) {
+    graph = LoadedGraph();
+    if (planted != nullptr) {
+        planted->clear();
+    }
+    if (!validSpec(spec)) {
+        return false;
+    }
+    SeededRandom random(spec.seed);
+    graph.n = spec.n;
+
+    switch (spec.family) {
+    case FAMILY_GNP:
+        randomPairs(random, spec.n, spec.p, [&](int u, int v) {
+            graph.edges.push_back({u, v});
+        });
+        break;
+    case FAMILY_GNM:
+        generateGnm(spec, random, graph);
+        break;
+    case FAMILY_BA:
+        generateBarabasiAlbert(spec, random, graph);
+        break;
+    case FAMILY_GRID:
+        for (int r = 0; r < spec.rows; r++) {
+            for (int c = 0; c < spec.cols; c++) {
+                int v = r * spec.cols + c;
+                if (c + 1 < spec.cols) {
+                    graph.edges.push_back({v, v + 1});
+                }
+                if (r + 1 < spec.rows) {
+                    graph.edges.push_back({v, v + spec.cols});
+                }
+            }
+        }
+        break;
+    case FAMILY_BIPARTITE:
+        randomCells(random, spec.left, spec.n - spec.left, spec.p, [&](int u, int v) {
+            graph.edges.push_back({u, spec.left + v});
+        });
+        break;
+    case FAMILY_PLANTED:
+        generatePlanted(spec, random, graph, planted);
+        break;
+    }
+    return true;
+}
+
+/**
+ * Reads a whole number parameter, printing an error if the value is not one.
+ */
+static bool parseInteger(const std::string& key, const std::string& value, long long& result) {
+    char* end = nullptr;
+    result = std::strtoll(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0') {
+        std::cerr << "Error: Generator parameter " << key << " must be an integer.\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Parses a generator spec: a family name, then comma separated key=value parameters.
+ *   gnp:n=<int>,p=<real>          gnm:n=<int>,m=<int>        ba:n=<int>,m=<int>
+ *   grid:rows=<int>,cols=<int>    bipartite:left=<int>,right=<int>,p=<real>
+ *   planted:n=<int>,k=<int>,p=<real>
+ * Every family takes seed=<int>, default 1.
+ *
+ * @param text the spec
+ * @param spec receives the parameters
+ * @return false and prints an error if the spec is malformed
+ */
+bool parseGeneratorSpec(const std::string& text, GeneratorSpec& spec) {
+    spec = GeneratorSpec();
+    size_t colon = text.find(':');
+    std::string family = text.substr(0, colon);
+    if (family == "gnp") {
+        spec.family = FAMILY_GNP;
+    } else if (family == "gnm") {
+        spec.family = FAMILY_GNM;
+    } else if (family == "ba") {
+        spec.family = FAMILY_BA;
+    } else if (family == "grid") {
+        spec.family = FAMILY_GRID;
+    } else if (family == "bipartite") {
+        spec.family = FAMILY_BIPARTITE;
+    } else if (family == "planted") {
+        spec.family = FAMILY_PLANTED;
+    } else {
+        std::cerr << "Error: Unknown graph family " << family << ". Use gnp, gnm, ba, grid, bipartite or planted.\n";
+        return false;
+    }
+
+    long long right = 0;
+    size_t start = colon == std::string::npos ? text.size() : colon + 1;
+    while (start < text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == std::string::npos) {
+            comma = text.size();
+        }
+        std::string item = text.substr(start, comma - start);
+        start = comma + 1;
+
+        size_t equals = item.find('=');
+        if (equals == std::string::npos) {
+            std::cerr << "Error: Generator parameter " << item << " should take the form key=value.\n";
+            return false;
+        }
+        std::string key = item.substr(0, equals);
+        std::string value = item.substr(equals + 1);
+        long long number = 0;
+
+        if (key == "p") {
+            char* end = nullptr;
+            spec.p = std::strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0') {
+                std::cerr << "Error: Generator parameter p must be a number.\n";
+                return false;
+            }
+            continue;
+        }
+        if (!parseInteger(key, value, number)) {
+            return false;
+        }
+        if (key != "m" && key != "seed" && (number < INT_MIN || number > INT_MAX)) {
+            std::cerr << "Error: Generator parameter " << key << " is out of range.\n";
+            return false;
+        }
+        if (key == "n") {
+            spec.n = number;
+        } else if (key == "m") {
+            spec.m = number;
+        } else if (key == "rows") {
+            spec.rows = number;
+        } else if (key == "cols") {
+            spec.cols = number;
+        } else if (key == "left") {
+            spec.left = number;
+        } else if (key == "right") {
+            right = number;
+        } else if (key == "k") {
+            spec.k = number;
+        } else if (key == "seed") {
+            spec.seed = number;
+        } else {
+            std::cerr << "Error: Unknown generator parameter " << key << ".\n";
+            return false;
+        }
+    }
+
+    if (spec.family == FAMILY_GRID) {                               // The vertex count follows from the shape
+        long long n = (long long)spec.rows * spec.cols;
+        spec.n = n <= INT_MAX ? n : -1;
+    } else if (spec.family == FAMILY_BIPARTITE) {
+        long long n = (long long)spec.left + right;
+        spec.n = right >= 0 && n <= INT_MAX ? n : -1;
+    }
+    return true;
+}
+
+/**
+ * Writes a graph as V, W and E commands, vertices numbered from 1. W is only written when the
+ * graph has vertex weights, so the output also reads back through cnf_converter.py.
+ *
+ * @param out the destination
+ * @param graph the graph
+ */
+void writeGraph(std::ostream& out, const LoadedGraph& graph) {
+    out << "V " << graph.n << "\n";
+    if (!graph.weights.empty()) {
+        out << "W {";
+        for (size_t v = 0; v < graph.weights.size(); v++) {
+            out << (v == 0 ? "" : ",") << "<" << v + 1 << "," << graph.weights[v] << ">";
+        }
+        out << "}\n";
+    }
+    out << "E {";
+    for (size_t i = 0; i < graph.edges.size(); i++) {
+        out << (i == 0 ? "" : ",") << "<" << graph.edges[i][0] + 1 << "," << graph.edges[i][1] + 1 << ">";
+    }
+    out << "}\n";
+}
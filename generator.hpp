@@ -0,0 +1,54 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+#include "loader.hpp"
+
+enum GraphFamily {
+    FAMILY_GNP,                                     // Every pair joined with probability p
+    FAMILY_GNM,                                     // m pairs drawn uniformly without replacement
+    FAMILY_BA,                                      // Barabasi-Albert, each new vertex joins m vertices by degree
+    FAMILY_GRID,                                    // rows x cols lattice
+    FAMILY_BIPARTITE,                               // Left and right sides, each cross pair with probability p
+    FAMILY_PLANTED                                  // Hidden cover of size k, which is the minimum
+};
+
+// Parameters of one generated graph, read from a spec such as gnp:n=1000,p=0.01,seed=7
+struct GeneratorSpec {
+    GraphFamily family = FAMILY_GNP;
+    int n = 0;                                      // Vertices, rows * cols for grids, left + right for bipartite
+    long long m = 0;                                // Edges of gnm, edges per new vertex of ba
+    double p = 0;                                   // Edge probability of gnp, bipartite and planted
+    int rows = 0;
+    int cols = 0;
+    int left = 0;                                   // Left side of bipartite graphs
+    int k = 0;                                      // Planted cover size, at most n / 2
+    uint64_t seed = 1;
+};
+
+/**
+ * SeededRandom Class
+ * SplitMix64 generator. Unlike the standard distributions its output is fixed by the seed on
+ * every platform, so a spec always names the same graph.
+ */
+class SeededRandom {
+    uint64_t state;
+
+public:
+    explicit SeededRandom(uint64_t seed);
+
+    uint64_t next();
+    uint64_t below(uint64_t bound);
+    double unit();
+};
+
+bool parseGeneratorSpec(const std::string& text, GeneratorSpec& spec);
+bool generateGraph(const GeneratorSpec& spec, LoadedGraph& graph, std::vector<int>* planted = nullptr);
+void writeGraph(std::ostream& out, const LoadedGraph& graph);
+
+
+#endif
@@ -0,0 +1,170 @@
+#include <vector>
+#include <array>
+#include <algorithm>
+
+#include "graph.hpp"
+
+/**
+ * AdjacencyList Class
+ * Enables linear time traversal of sparse graphs without the n x n matrix.
+ */
+AdjacencyList::AdjacencyList() : n(0), offset(1, 0) {}
+
+int AdjacencyList::degree(int v) const {
+    return offset[v+1] - offset[v];
+}
+
+/**
+ * Returns true if the edge (u, v) exists, by binary search in the row of u.
+ */
+bool AdjacencyList::adjacent(int u, int v) const {
+    return std::binary_search(begin(u), end(u), v);
+}
+
+const int* AdjacencyList::begin(int v) const {
+    return target.data() + offset[v];
+}
+
+const int* AdjacencyList::end(int v) const {
+    return target.data() + offset[v+1];
+}
+
+/**
+ * Returns the number of distinct edges, counting a self loop once.
+ */
+size_t AdjacencyList::edgeCount() const {
+    size_t loops = 0;
+    for (int v = 0; v < n; v++) {
+        loops += adjacent(v, v) ? 1 : 0;
+    }
+    return (target.size() + loops) / 2;
+}
+
+/**
+ * Builds the adjacency of an edge list with a counting pass, so memory stays linear in n + m.
+ *
+ * @param n the number of vertices
+ * @param edges the edges, vertices numbered from 0, duplicates allowed
+ * @return the adjacency
+ */
+AdjacencyList buildAdjacency(int n, const std::vector<std::array<int,2>>& edges) {
+    AdjacencyList graph;
+    std::vector<size_t> fill(n + 1, 0);
+    graph.n = n;
+
+    for (const auto& edge : edges) {                                // Degree of each vertex
+        ++fill[edge[0] + 1];
+        if (edge[0] != edge[1]) {
+            ++fill[edge[1] + 1];
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        fill[v+1] += fill[v];
+    }
+    graph.offset = fill;
+    graph.target.resize(fill[n]);
+
+    for (const auto& edge : edges) {
+        graph.target[fill[edge[0]]++] = edge[1];
+        if (edge[0] != edge[1]) {
+            graph.target[fill[edge[1]]++] = edge[0];
+        }
+    }
+
+    size_t write = 0;                                               // Sort rows and drop duplicate edges
+    for (int v = 0; v < n; v++) {
+        size_t begin = graph.offset[v];
+        size_t end = graph.offset[v+1];
+        std::sort(graph.target.begin() + begin, graph.target.begin() + end);
+        graph.offset[v] = write;
+        for (size_t i = begin; i < end; i++) {
+            if (i == begin || graph.target[i] != graph.target[i-1]) {
+                graph.target[write++] = graph.target[i];
+            }
+        }
+    }
+    graph.offset[n] = write;
+    graph.target.resize(write);
+    graph.target.shrink_to_fit();
+
+    return graph;
+}
+
+/**
+ * Repeatedly takes the vertex with the most uncovered edges, like greedySolver1 but in
+ * O(n + m) with a bucket queue. Stale queue entries are skipped when popped. Self loops
+ * put their vertex in the cover first.
+ *
+ * @param graph the graph
+ * @return the cover, sorted
+ */
+std::vector<int> greedyVertexCover(const AdjacencyList& graph) {
+    std::vector<int> degree(graph.n, 0);
+    std::vector<char> inCover(graph.n, 0);
+    std::vector<std::vector<int>> bucket(graph.n + 1);
+    std::vector<int> cover;
+    int top = 0;
+
+    for (int v = 0; v < graph.n; v++) {
+        if (graph.adjacent(v, v)) {
+            inCover[v] = 1;
+        }
+    }
+    for (int v = 0; v < graph.n; v++) {
+        for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+            degree[v] += (*u != v && !inCover[*u]) ? 1 : 0;
+        }
+        if (!inCover[v] && degree[v] > 0) {
+            bucket[degree[v]].push_back(v);
+            top = std::max(top, degree[v]);
+        }
+    }
+
+    while (top > 0) {
+        if (bucket[top].empty()) {
+            --top;
+            continue;
+        }
+        int v = bucket[top].back();
+        bucket[top].pop_back();
+        if (inCover[v] || degree[v] != top) {                       // Stale entry
+            continue;
+        }
+        inCover[v] = 1;
+        for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+            if (!inCover[*u] && --degree[*u] > 0) {
+                bucket[degree[*u]].push_back(*u);
+            }
+        }
+    }
+
+    for (int v = 0; v < graph.n; v++) {
+        if (inCover[v]) {
+            cover.push_back(v);
+        }
+    }
+    return cover;
+}
+
+/**
+ * Checks that every edge has an endpoint in the cover.
+ *
+ * @param n the number of vertices
+ * @param edges the edges, vertices numbered from 0
+ * @param cover the cover, vertices numbered from 0
+ */
+bool isVertexCover(int n, const std::vector<std::array<int,2>>& edges, const std::vector<int>& cover) {
+    std::vector<bool> inCover(n, false);
+    for (int v : cover) {
+        if (v < 0 || v >= n) {
+            return false;
+        }
+        inCover[v] = true;
+    }
+    for (const auto& edge : edges) {
+        if (!inCover[edge[0]] && !inCover[edge[1]]) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,34 @@
+#ifndef GRAPH_HPP
+#define GRAPH_HPP
+
+#include <vector>
+#include <array>
+#include <cstddef>
+
+/**
+ * AdjacencyList Class
+ * Compressed sparse row adjacency of an undirected graph. The neighbors of v are
+ * target[offset[v]] .. target[offset[v+1]-1], sorted and without duplicates. A self
+ * loop lists the vertex as its own neighbor.
+ */
+class AdjacencyList {
+public:
+    int n;
+    std::vector<size_t> offset;
+    std::vector<int> target;
+
+    AdjacencyList();
+
+    int degree(int v) const;
+    bool adjacent(int u, int v) const;
+    const int* begin(int v) const;
+    const int* end(int v) const;
+    size_t edgeCount() const;
+};
+
+AdjacencyList buildAdjacency(int n, const std::vector<std::array<int,2>>& edges);
+std::vector<int> greedyVertexCover(const AdjacencyList& graph);
+bool isVertexCover(int n, const std::vector<std::array<int,2>>& edges, const std::vector<int>& cover);
+
+
+#endif
@@ -0,0 +1,15 @@
+#include "internal.h"
+#include "kissat-stats.h"
+
+/**
+ * Copies the search counters of a Kissat solver. Compiled as C against the
+ * Kissat sources since the public API has no accessor for them.
+ *
+ * @param solver the solver after kissat_solve returned
+ */
+void kissatCounters(kissat* solver, uint64_t* conflicts, uint64_t* decisions, uint64_t* propagations, uint64_t* restarts) {
+    *conflicts = solver->statistics.conflicts;
+    *decisions = solver->statistics.decisions;
+    *propagations = solver->statistics.propagations;
+    *restarts = solver->statistics.restarts;
+}
@@ -0,0 +1,19 @@
+#ifndef KISSAT_STATS_H
+#define KISSAT_STATS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "kissat.h"
+
+// Kissat only prints its statistics, this reads them from the solver internals
+void kissatCounters(kissat* solver, uint64_t* conflicts, uint64_t* decisions, uint64_t* propagations, uint64_t* restarts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,538 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "loader.hpp"
+#include "matching.hpp"
+
+// Share of the file parsed by one thread, cut at line boundaries
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    std::vector<std::array<int,2>> edges;
+    std::vector<std::array<int,2>> weights;         // Vertex and weight pairs
+    long long maxId = -1;
+    long long lines = 0;                            // METIS: vertex lines in the chunk
+    long long first = 0;                            // METIS: vertex of the first line
+    long long vertices = -1;                        // DIMACS: n of the p line, if the chunk has it
+    int headers = 0;                                // DIMACS: number of p lines seen
+    const char* error = nullptr;                    // Start of the first malformed line
+};
+
+// Layout of the METIS vertex lines, from the fmt and ncon header fields
+struct MetisLayout {
+    long long n = 0;
+    bool sizes = false;                             // Each line starts with the vertex size
+    int weights = 0;                                // Then this many vertex weights, the first is used
+    bool edgeWeights = false;
+};
+
+/**
+ * MappedFile Class
+ * Maps the file so the parsers read it in place instead of copying it into strings.
+ *
+ * @param path the file to map
+ */
+MappedFile::MappedFile(const std::string& path) : fd(-1), map(nullptr), length(0) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+    length = info.st_size;
+    if (length == 0) {
+        return;
+    }
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+        ::close(fd);
+        fd = -1;
+        length = 0;
+        return;
+    }
+    madvise(address, length, MADV_SEQUENTIAL);
+    map = static_cast<const char*>(address);
+}
+
+MappedFile::~MappedFile() {
+    if (map != nullptr) {
+        munmap(const_cast<char*>(map), length);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+bool MappedFile::isOpen() const {
+    return fd >= 0;
+}
+
+const char* MappedFile::data() const {
+    return map;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
+
+static const char* lineEnd(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', end - p);
+    return newline != nullptr ? static_cast<const char*>(newline) : end;
+}
+
+static const char* skipSpace(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * Reads a non-negative integer after optional blanks.
+ *
+ * @return the position after the number, nullptr if there is none or it exceeds INT_MAX
+ */
+static const char* parseNumber(const char* p, const char* end, long long& value) {
+    p = skipSpace(p, end);
+    const char* start = p;
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        if (value > INT_MAX) {
+            return nullptr;
+        }
+        ++p;
+    }
+    if (p == start || (p < end && *p != ' ' && *p != '\t' && *p != '\r')) {
+        return nullptr;
+    }
+    return p;
+}
+
+/**
+ * Cuts [begin, end) into at most parts chunks of similar size that each end after a newline.
+ */
+static std::vector<Chunk> splitChunks(const char* begin, const char* end, int parts) {
+    std::vector<Chunk> chunks;
+    size_t size = end - begin;
+    const char* p = begin;
+
+    for (int i = 0; i < parts && p < end; i++) {
+        const char* stop = (i == parts - 1) ? end : std::max(p, begin + size * (i + 1) / parts);
+        if (stop < end) {
+            stop = lineEnd(stop, end);
+            stop = stop < end ? stop + 1 : end;
+        }
+        Chunk chunk;
+        chunk.begin = p;
+        chunk.end = stop;
+        chunks.push_back(chunk);
+        p = stop;
+    }
+
+    return chunks;
+}
+
+/**
+ * Runs parse on every chunk, the first on the calling thread and the rest on their own threads.
+ */
+template <typename Parse>
+static void parseChunks(std::vector<Chunk>& chunks, Parse parse) {
+    std::vector<std::thread> pool;
+    for (size_t c = 1; c < chunks.size(); c++) {
+        pool.push_back(std::thread([&chunks, &parse, c]() { parse(chunks[c]); }));
+    }
+    if (!chunks.empty()) {
+        parse(chunks[0]);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+/**
+ * Parses "u v" lines. Extra columns such as timestamps are ignored.
+ */
+static void parseSnap(Chunk& chunk) {
+    for (const char* p = chunk.begin; p < chunk.end; ) {
+        const char* eol = lineEnd(p, chunk.end);
+        const char* q = skipSpace(p, eol);
+        if (q < eol && *q != '#' && *q != '%') {                    // Skips comments and blank lines
+            long long u, v;
+            q = parseNumber(q, eol, u);
+            if (q != nullptr) {
+                q = parseNumber(q, eol, v);
+            }
+            if (q == nullptr) {
+                chunk.error = p;
+                return;
+            }
+            chunk.edges.push_back({(int)u, (int)v});
+            chunk.maxId = std::max(chunk.maxId, std::max(u, v));
+        }
+        p = eol + 1;
+    }
+}
+
+/**
+ * Parses "p edge n m", "e u v" and "n v weight" lines. Comments are skipped.
+ */
+static void parseDimacs(Chunk& chunk) {
+    for (const char* p = chunk.begin; p < chunk.end; ) {
+        const char* eol = lineEnd(p, chunk.end);
+        const char* q = skipSpace(p, eol);
+        long long u, v;
+
+        if (q == eol || *q == 'c') {
+            p = eol + 1;
+            continue;
+        }
+        if (*q == 'e') {
+            q = parseNumber(q + 1, eol, u);
+            if (q != nullptr) {
+                q = parseNumber(q, eol, v);
+            }
+            if (q == nullptr || u < 1 || v < 1) {
+                chunk.error = p;
+                return;
+            }
+            chunk.edges.push_back({(int)u - 1, (int)v - 1});
+            chunk.maxId = std::max(chunk.maxId, std::max(u, v) - 1);
+        } else if (*q == 'n') {
+            q = parseNumber(q + 1, eol, u);
+            if (q != nullptr) {
+                q = parseNumber(q, eol, v);
+            }
+            if (q == nullptr || u < 1) {
+                chunk.error = p;
+                return;
+            }
+            chunk.weights.push_back({(int)u - 1, (int)v});
+            chunk.maxId = std::max(chunk.maxId, u - 1);
+        } else if (*q == 'p') {
+            q = skipSpace(q + 1, eol);
+            while (q < eol && *q != ' ' && *q != '\t') {            // Problem name, edge or col
+                ++q;
+            }
+            q = parseNumber(q, eol, u);
+            if (q != nullptr) {
+                q = parseNumber(q, eol, v);
+            }
+            if (q == nullptr) {
+                chunk.error = p;
+                return;
+            }
+            chunk.vertices = u;
+            ++chunk.headers;
+        } else {
+            chunk.error = p;
+            return;
+        }
+        p = eol + 1;
+    }
+}
+
+static bool metisComment(const char* p, const char* eol) {
+    return p < eol && *p == '%';
+}
+
+/**
+ * Counts the vertex lines of a METIS chunk. Blank lines are vertices without neighbors.
+ */
+static void countMetis(Chunk& chunk) {
+    for (const char* p = chunk.begin; p < chunk.end; ) {
+        const char* eol = lineEnd(p, chunk.end);
+        if (!metisComment(p, eol)) {
+            ++chunk.lines;
+        }
+        p = eol + 1;
+    }
+}
+
+/**
+ * Parses the neighbor lines of a METIS chunk. Every edge is listed from both ends, so only the
+ * copy from its lower endpoint is kept.
+ */
+static void parseMetis(Chunk& chunk, const MetisLayout& layout) {
+    long long vertex = chunk.first;
+
+    for (const char* p = chunk.begin; p < chunk.end; ) {
+        const char* eol = lineEnd(p, chunk.end);
+        if (metisComment(p, eol)) {
+            p = eol + 1;
+            continue;
+        }
+        const char* q = skipSpace(p, eol);
+        long long value;
+
+        if (q == eol) {                                             // No neighbors
+            ++vertex;
+            p = eol + 1;
+            continue;
+        }
+        if (vertex >= layout.n) {                                   // More vertex lines than the header declares
+            chunk.error = p;
+            return;
+        }
+        if (layout.sizes) {
+            q = parseNumber(q, eol, value);
+        }
+        for (int i = 0; i < layout.weights && q != nullptr; i++) {
+            q = parseNumber(q, eol, value);
+            if (i == 0 && q != nullptr) {
+                chunk.weights.push_back({(int)vertex, (int)value});
+            }
+        }
+        while (q != nullptr && (q = skipSpace(q, eol)) < eol) {
+            q = parseNumber(q, eol, value);
+            if (q == nullptr || value < 1 || value > layout.n) {
+                q = nullptr;
+                break;
+            }
+            if (vertex <= value - 1) {
+                chunk.edges.push_back({(int)vertex, (int)value - 1});
+            }
+            if (layout.edgeWeights) {
+                q = parseNumber(q, eol, value);
+            }
+        }
+        if (q == nullptr) {
+            chunk.error = p;
+            return;
+        }
+        ++vertex;
+        p = eol + 1;
+    }
+}
+
+/**
+ * Reads the METIS header line "n m [fmt [ncon]]" after any comments.
+ *
+ * @return the start of the first vertex line, nullptr if the header is malformed
+ */
+static const char* metisHeader(const char* p, const char* end, MetisLayout& layout) {
+    const char* eol = lineEnd(p, end);
+    while (p < end && (metisComment(p, eol) || skipSpace(p, eol) == eol)) {
+        p = eol + 1;
+        eol = p < end ? lineEnd(p, end) : end;
+    }
+    if (p >= end) {
+        return nullptr;
+    }
+
+    long long n, m, fmt = 0, ncon = 1;
+    const char* q = parseNumber(p, eol, n);
+    if (q != nullptr) {
+        q = parseNumber(q, eol, m);
+    }
+    if (q != nullptr && skipSpace(q, eol) < eol) {
+        q = parseNumber(q, eol, fmt);                               // Digits: vertex sizes, vertex weights, edge weights
+        if (q != nullptr && skipSpace(q, eol) < eol) {
+            q = parseNumber(q, eol, ncon);
+        }
+    }
+    if (q == nullptr) {
+        return nullptr;
+    }
+
+    layout.n = n;
+    layout.edgeWeights = fmt % 10 == 1;
+    layout.sizes = fmt / 100 % 10 == 1;
+    layout.weights = fmt / 10 % 10 == 1 ? (int)ncon : 0;
+    return eol < end ? eol + 1 : end;
+}
+
+/**
+ * Returns the format named on the command line, FORMAT_AUTO for anything unknown.
+ */
+GraphFormat formatFromName(const std::string& name) {
+    if (name == "snap") {
+        return FORMAT_SNAP;
+    } else if (name == "dimacs") {
+        return FORMAT_DIMACS;
+    } else if (name == "metis") {
+        return FORMAT_METIS;
+    }
+    return FORMAT_AUTO;
+}
+
+/**
+ * Picks the format from the file extension, then from the first character of the file.
+ * METIS files are only recognized by extension.
+ */
+GraphFormat guessFormat(const std::string& path, const char* data, size_t size) {
+    std::string extension = path.substr(path.find_last_of('.') == std::string::npos ? path.size() : path.find_last_of('.'));
+    if (extension == ".col" || extension == ".clq" || extension == ".dimacs") {
+        return FORMAT_DIMACS;
+    } else if (extension == ".graph" || extension == ".metis") {
+        return FORMAT_METIS;
+    }
+    if (size > 0 && (data[0] == 'c' || data[0] == 'p')) {
+        return FORMAT_DIMACS;
+    }
+    return FORMAT_SNAP;
+}
+
+/**
+ * Reports the line number of a malformed line.
+ */
+static void reportError(const std::string& path, const char* data, const char* error) {
+    long long line = std::count(data, error, '\n') + 1;
+    std::cerr << "Error: Malformed line " << line << " in " << path << ".\n";
+}
+
+/**
+ * Reads a graph file. The file is memory mapped and cut into line aligned chunks that are
+ * parsed on separate threads; the per-thread edge lists are then joined in file order.
+ * SNAP ids are renumbered densely and kept as labels.
+ *
+ * @param path the file to read
+ * @param format the file format, FORMAT_AUTO to guess it
+ * @param threads the number of threads, 0 for one per hardware thread
+ * @param graph the graph read
+ * @return false if the file could not be read, after printing the reason
+ */
+static bool readGraph(const std::string& path, GraphFormat format, int threads, LoadedGraph& graph) {
+    MappedFile file(path);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Cannot open " << path << ".\n";
+        return false;
+    }
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+    if (format == FORMAT_AUTO) {
+        format = guessFormat(path, begin, file.size());
+    }
+
+    MetisLayout layout;
+    if (format == FORMAT_METIS) {
+        begin = file.size() > 0 ? metisHeader(begin, end, layout) : nullptr;
+        if (begin == nullptr) {
+            std::cerr << "Error: Missing or malformed METIS header in " << path << ".\n";
+            return false;
+        }
+    }
+
+    int parts = std::max(1, (int)std::min<size_t>(threadCount(threads), (end - begin) / (1 << 20) + 1));   // About 1 MiB per thread at least
+    std::vector<Chunk> chunks = splitChunks(begin, end, parts);
+
+    if (format == FORMAT_SNAP) {
+        parseChunks(chunks, parseSnap);
+    } else if (format == FORMAT_DIMACS) {
+        parseChunks(chunks, parseDimacs);
+    } else {
+        parseChunks(chunks, countMetis);
+        long long first = 0;
+        for (auto& chunk : chunks) {                                // Vertex of each chunk's first line
+            chunk.first = first;
+            first += chunk.lines;
+        }
+        parseChunks(chunks, [&layout](Chunk& chunk) { parseMetis(chunk, layout); });
+    }
+
+    size_t total = 0;
+    long long maxId = -1;
+    long long vertices = -1;
+    int headers = 0;
+    for (const auto& chunk : chunks) {
+        if (chunk.error != nullptr) {
+            reportError(path, file.data(), chunk.error);
+            return false;
+        }
+        total += chunk.edges.size();
+        maxId = std::max(maxId, chunk.maxId);
+        headers += chunk.headers;
+        vertices = std::max(vertices, chunk.vertices);
+    }
+
+    graph = LoadedGraph();
+    graph.edges.reserve(total);
+    std::vector<std::array<int,2>> weights;
+    for (auto& chunk : chunks) {
+        weights.insert(weights.end(), chunk.weights.begin(), chunk.weights.end());
+    }
+    for (auto& chunk : chunks) {                                    // Joins in file order and frees as it goes
+        graph.edges.insert(graph.edges.end(), chunk.edges.begin(), chunk.edges.end());
+        std::vector<std::array<int,2>>().swap(chunk.edges);
+    }
+
+    if (format == FORMAT_DIMACS) {
+        if (headers != 1) {
+            std::cerr << "Error: Expected one p line in " << path << ".\n";
+            return false;
+        }
+        if (maxId >= vertices) {
+            std::cerr << "Error: Edge endpoint " << maxId + 1 << " exceeds the " << vertices << " vertices declared in " << path << ".\n";
+            return false;
+        }
+        graph.n = vertices;
+    } else if (format == FORMAT_METIS) {
+        graph.n = layout.n;
+    } else {
+        std::vector<int> ids;                                       // Renumbers the ids that occur in sorted order
+        ids.reserve(2 * graph.edges.size());
+        for (const auto& edge : graph.edges) {
+            ids.push_back(edge[0]);
+            ids.push_back(edge[1]);
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        for (auto& edge : graph.edges) {                            // Sized by the distinct ids, not the largest one
+            edge = {(int)(std::lower_bound(ids.begin(), ids.end(), edge[0]) - ids.begin()),
+                    (int)(std::lower_bound(ids.begin(), ids.end(), edge[1]) - ids.begin())};
+        }
+        graph.labels.swap(ids);
+        graph.n = graph.labels.size();
+    }
+
+    if (!weights.empty()) {                                         // Vertices without a weight cost 1
+        graph.weights.assign(graph.n, 1);
+        for (const auto& weight : weights) {
+            graph.weights[weight[0]] = weight[1];
+        }
+    }
+
+    for (auto& edge : graph.edges) {                                // Drops repeated and reversed edges
+        if (edge[0] > edge[1]) {
+            std::swap(edge[0], edge[1]);
+        }
+    }
+    std::sort(graph.edges.begin(), graph.edges.end());
+    graph.edges.erase(std::unique(graph.edges.begin(), graph.edges.end()), graph.edges.end());
+
+    return true;
+}
+
+/**
+ * Reads a graph file, reporting a graph too large for memory instead of terminating.
+ *
+ * @param path the file to read
+ * @param format the file format, FORMAT_AUTO to guess it
+ * @param threads the number of threads, 0 for one per hardware thread
+ * @param graph the graph read
+ * @return false if the file could not be read, after printing the reason
+ */
+bool loadGraph(const std::string& path, GraphFormat format, int threads, LoadedGraph& graph) {
+    try {
+        return readGraph(path, format, threads, graph);
+    } catch (const std::bad_alloc&) {
+        graph = LoadedGraph();
+        std::cerr << "Error: Not enough memory to load " << path << ".\n";
+        return false;
+    }
+}
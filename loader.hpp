@@ -0,0 +1,49 @@
+#ifndef LOADER_HPP
+#define LOADER_HPP
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstddef>
+
+enum GraphFormat {
+    FORMAT_AUTO,
+    FORMAT_SNAP,                                    // "u v" per line, '#' comments, ids from 0
+    FORMAT_DIMACS,                                  // "p edge n m" then "e u v" and "n v weight", 'c' comments, ids from 1
+    FORMAT_METIS                                    // "n m [fmt [ncon]]" then one neighbor line per vertex, '%' comments
+};
+
+// A graph read from a benchmark file
+struct LoadedGraph {
+    int n = 0;
+    std::vector<std::array<int,2>> edges;           // Vertices numbered from 0, no duplicates
+    std::vector<int> labels;                        // File id of each vertex, empty when vertex v is v+1
+    std::vector<long long> weights;                 // Vertex weights, empty when the file has none
+};
+
+/**
+ * MappedFile Class
+ * Read-only memory map of a whole file, unmapped on destruction.
+ */
+class MappedFile {
+    int fd;
+    const char* map;
+    size_t length;
+
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const;
+    const char* data() const;
+    size_t size() const;
+};
+
+GraphFormat formatFromName(const std::string& name);
+GraphFormat guessFormat(const std::string& path, const char* data, size_t size);
+bool loadGraph(const std::string& path, GraphFormat format, int threads, LoadedGraph& graph);
+
+
+#endif
@@ -0,0 +1,121 @@
+#include <vector>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+
+#include "matching.hpp"
+
+// Vertex states shared by the matching threads
+static const uint8_t FREE = 0;
+static const uint8_t LOCKED = 1;                    // Held by a thread while it claims the other endpoint
+static const uint8_t MATCHED = 2;
+static const uint8_t LOOP = 3;                      // Has a self loop, in every cover
+
+/**
+ * Returns the number of threads to use.
+ *
+ * @param requested the requested number of threads, 0 for one per hardware thread
+ */
+int threadCount(int requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    int hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+}
+
+/**
+ * Claims the endpoints of each edge in [begin, end) that has no covered endpoint yet.
+ * The lower endpoint is locked first, so a thread only ever waits on a higher vertex and
+ * no cycle of waiting threads can form.
+ *
+ * @return the number of edges matched plus self loops claimed
+ */
+static size_t claimEdges(std::vector<std::atomic<uint8_t>>& state, const std::vector<std::array<int,2>>& edges, size_t begin, size_t end) {
+    size_t claimed = 0;
+
+    for (size_t e = begin; e < end; e++) {
+        int lo = std::min(edges[e][0], edges[e][1]);
+        int hi = std::max(edges[e][0], edges[e][1]);
+
+        while (true) {
+            uint8_t s = state[lo].load(std::memory_order_acquire);
+            if (s == MATCHED || s == LOOP) {                        // Edge already covered
+                break;
+            }
+            if (s == LOCKED || !state[lo].compare_exchange_weak(s, lo == hi ? LOOP : LOCKED)) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (lo == hi) {
+                ++claimed;
+                break;
+            }
+
+            while (true) {                                          // Holding lo, try to match hi
+                uint8_t t = state[hi].load(std::memory_order_acquire);
+                if (t == MATCHED || t == LOOP) {
+                    state[lo].store(FREE, std::memory_order_release);
+                    break;
+                }
+                if (t == FREE && state[hi].compare_exchange_weak(t, MATCHED)) {
+                    state[lo].store(MATCHED, std::memory_order_release);
+                    ++claimed;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            break;
+        }
+    }
+
+    return claimed;
+}
+
+/**
+ * Computes a maximal matching with lock-free edge claiming across threads and returns both
+ * endpoints of every matched edge. Any cover needs one endpoint per matched edge, so the cover
+ * is at most twice the optimum. The matching found depends on thread scheduling.
+ *
+ * @param n the number of vertices
+ * @param edges the edges, vertices numbered from 0
+ * @param threads the number of threads, 0 for one per hardware thread
+ * @return the cover and its lower bound
+ */
+MatchingCover matchingVertexCover(int n, const std::vector<std::array<int,2>>& edges, int threads) {
+    std::vector<std::atomic<uint8_t>> state(n);
+    MatchingCover result;
+    result.lowerBound = 0;
+
+    for (int v = 0; v < n; v++) {
+        state[v].store(FREE, std::memory_order_relaxed);
+    }
+
+    size_t workers = std::min((size_t)threadCount(threads), edges.size() / 65536 + 1);   // Small graphs stay on one thread
+    std::vector<size_t> claimed(workers, 0);
+    std::vector<std::thread> pool;
+    size_t chunk = (edges.size() + workers - 1) / workers;
+
+    for (size_t t = 1; t < workers; t++) {
+        size_t begin = std::min(edges.size(), t * chunk);
+        size_t end = std::min(edges.size(), begin + chunk);
+        pool.push_back(std::thread([&, t, begin, end]() { claimed[t] = claimEdges(state, edges, begin, end); }));
+    }
+    claimed[0] = claimEdges(state, edges, 0, std::min(edges.size(), chunk));
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < workers; t++) {
+        result.lowerBound += claimed[t];
+    }
+    for (int v = 0; v < n; v++) {
+        if (state[v].load(std::memory_order_relaxed) != FREE) {
+            result.cover.push_back(v);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,18 @@
+#ifndef MATCHING_HPP
+#define MATCHING_HPP
+
+#include <vector>
+#include <array>
+#include <cstddef>
+
+// A 2-approximate vertex cover and the lower bound that proves it
+struct MatchingCover {
+    std::vector<int> cover;                         // Sorted, vertices numbered from 0
+    size_t lowerBound;                              // Matched edges plus self loops, no cover is smaller
+};
+
+int threadCount(int requested);
+MatchingCover matchingVertexCover(int n, const std::vector<std::array<int,2>>& edges, int threads);
+
+
+#endif
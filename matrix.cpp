@@ -4,10 +4,21 @@
 #include <vector>
 #include <algorithm>
 #include <climits>
-#include <map>
+#include <cstdlib>
 #include <chrono>
 
 #include "matrix.hpp"
+#include "encoder.hpp"
+#include "bitmatrix.hpp"
+#include "clique.hpp"
+#include "graph.hpp"
+#include "optimize.hpp"
+#include "weighted.hpp"
+#include "treewidth.hpp"
+#include "bipartite.hpp"
+#include "formatter.hpp"
+#include "matching.hpp"
+#include "satcover.hpp"
 // defined std::unique_ptr
 #include <memory>
 // defines Var and Lit
@@ -26,7 +37,7 @@
 
 // Constructor and Destructor
 Matrix::Matrix(int newRow, int newCol)
-    : row(newRow), col(newCol), graph(newRow, std::vector<int>(newCol)), distance(newRow, INT_MAX), parent(newRow, -1) {}
+    : row(newRow), col(newCol), graph(newRow, std::vector<int>(newCol)), adjacency(newRow), pathCache(DEFAULT_PATH_CACHE), stats(nullptr), memBudget(0), improve(false), threads(1), cubeDepth(0) {}
 
 Matrix::~Matrix() {}
 
@@ -66,8 +77,12 @@ void Matrix::set(int r, int c, int w) {
     }
     //std::cout << "Adding: (" << r+1 << ", " << c+1 << ")" << std::endl;
     edgeList.push_back({r, c});
+    pathCache.clear();                  // Cached shortest paths may no longer hold
+    tree.reset();
+    allPairs.reset();
     graph[r][c] = w;
     graph[c][r] = w;
+    adjacency.set(r, c);
 }
 
 /** 
@@ -94,6 +109,11 @@ void Matrix::print() {
     }
 
     // Parent and Distance
+    if (tree == nullptr) {
+        return;
+    }
+    const std::vector<int>& parent = tree->parent;
+    const std::vector<int>& distance = tree->distance;
     std::cout << "Parent Array: ";
     for (int i = 0; i < row; i++) {
         std::cout << parent[i] << ", ";
@@ -106,15 +126,143 @@ void Matrix::print() {
     std::cout << "\n";
 }
 
+/** 
+ * Records per-probe counters and timings of vcExact into the given statistics.
+ * 
+ * @param s the statistics of the current graph, nullptr to disable
+ */
+void Matrix::setStats(GraphStats* s) {
+    stats = s;
+}
+
+/** 
+ * Limits the memory of the shortest path trees kept for repeated S queries.
+ * 
+ * @param bytes the budget in bytes, 0 to disable the cache
+ */
+void Matrix::setPathCacheBudget(size_t bytes) {
+    pathCache.setBudget(bytes);
+}
+
+/** 
+ * Limits the memory an encoding may use. Larger probes fall back to the counter encoding or are refused.
+ * 
+ * @param bytes the budget in bytes, 0 for no limit
+ */
+void Matrix::setMemoryBudget(long long bytes) {
+    memBudget = bytes;
+}
+
+/** 
+ * Removes redundant vertices and makes 2-for-1 swaps in the greedy covers before they are printed.
+ * 
+ * @param enabled true to post-optimize
+ */
+void Matrix::setImprove(bool enabled) {
+    improve = enabled;
+}
+
+/** 
+ * Sets the threads that generate the clauses of each position encoding.
+ * 
+ * @param count the number of threads, 0 for one per hardware thread
+ */
+void Matrix::setThreads(int count) {
+    threads = count;
+}
+
+/** 
+ * Splits every SAT probe of vcExact into cubes over the given number of highest degree vertices.
+ * 
+ * @param depth the number of vertices decided per cube, 0 to solve each probe whole
+ */
+void Matrix::setCubeDepth(int depth) {
+    cubeDepth = depth;
+}
+
+/** 
+ * Names the vertices in printed covers, ex. with their ids in the input file.
+ * 
+ * @param names the name of each vertex, empty to number them from 1
+ */
+void Matrix::setLabels(const std::vector<int>& names) {
+    labels = names;
+}
+
+/** 
+ * Sets the cost of a vertex. The first weight makes the graph weighted, with every other vertex costing 1.
+ * 
+ * @param v the vertex
+ * @param w the weight, at least 0
+ */
+void Matrix::setVertexWeight(int v, long long w) {
+    if (v < 0 || v >= row || w < 0) {
+        std::cerr << "Error: Vertex weight (" << v+1 << ", " << w << ") is out of bounds.\n";
+        return;
+    }
+    if (vertexWeights.empty()) {
+        vertexWeights.assign(row, 1);
+    }
+    vertexWeights[v] = w;
+}
+
+bool Matrix::hasVertexWeights() const {
+    return !vertexWeights.empty();
+}
+
+/** 
+ * Returns the vertex weights, empty for an unweighted graph.
+ */
+const std::vector<long long>& Matrix::weights() const {
+    return vertexWeights;
+}
+
+/** 
+ * Returns the post-optimized cover when enabled, recording how many vertices were saved.
+ * 
+ * @param cover a cover, vertices numbered from 0
+ * @param name the prefix of the stats counters
+ */
+std::vector<int> Matrix::improved(std::vector<int> cover, const std::string& name) {
+    if (!improve) {
+        return cover;
+    }
+    ImproveResult result = improveCover(buildAdjacency(row, edgeList), cover, hasVertexWeights() ? &vertexWeights : nullptr);
+    if (stats != nullptr) {
+        stats->counters[name + "_removed"] = result.removed;
+        stats->counters[name + "_swaps"] = result.swaps;
+    }
+    return result.cover;
+}
+
+/** 
+ * Returns the edges added to the graph, vertices numbered from 0.
+ */
+const std::vector<std::array<int,2>>& Matrix::edges() const {
+    return edgeList;
+}
+
 /**
  * Solves dijkstra's algorithm and updates a parent and distance vectors with respect to the source.
  * 
  * @param source the source vertex
  */
 void Matrix::dijkstra(int source) {
+    if (allPairs != nullptr) {                              // S queries are answered from the all pairs matrices
+        return;
+    }
+    tree = pathCache.find(source);
+    if (tree != nullptr) {                                  // Same source since the last edge change
+        return;
+    }
+
     // Reset parent and distance vectors
-    std::fill(parent.begin(), parent.end(), -1);
-    std::fill(distance.begin(), distance.end(), INT_MAX);
+    std::shared_ptr<PathTree> computed = std::make_shared<PathTree>();
+    computed->source = source;
+    computed->parent.assign(row, -1);
+    computed->distance.assign(row, INT_MAX);
+    std::vector<int>& parent = computed->parent;
+    std::vector<int>& distance = computed->distance;
     std::vector<bool> visited(row, false);
     distance[source] = 0;
 
@@ -142,6 +290,25 @@ void Matrix::dijkstra(int source) {
             }
         }
     }
+
+    tree = computed;
+    pathCache.insert(computed);
+}
+
+/**
+ * Computes the distance and next-hop matrices of every pair of vertices, after which S queries
+ * follow next hops instead of running dijkstra.
+ * 
+ * @param threads the number of threads, 0 for one per hardware thread
+ * @return false if the matrices exceed the memory budget
+ */
+bool Matrix::allPairsShortestPaths(int threads) {
+    if (memBudget > 0 && AllPairs::bytes(row) > (size_t)memBudget) {
+        std::cerr << "Error: All pairs shortest paths for " << row << " vertices exceed the memory budget.\n";
+        return false;
+    }
+    allPairs = std::make_shared<AllPairs>(::allPairsShortestPaths(graph, row, threads));
+    return true;
 }
 
 /**
@@ -157,6 +324,22 @@ std::string Matrix::printPathway(int source, int target, int size) {
     int update = target;
     int count = 0;
 
+    if (allPairs != nullptr) {                              // Answered from the all pairs matrices
+        pathway = allPairs->path(source, target);
+        if (pathway.empty()) {
+            return "No path exists.";
+        }
+        for (size_t i = 0; i < pathway.size(); i++) {
+            path.append(std::to_string(pathway[i]+1) + (i+1 < pathway.size() ? "-" : " "));
+        }
+        return path + std::to_string(allPairs->distance(source, target));
+    }
+    if (tree == nullptr || tree->source != source) {        // Answered from the tree of the source
+        dijkstra(source);
+    }
+    const std::vector<int>& parent = tree->parent;
+    const std::vector<int>& distance = tree->distance;
+
     pathway.push_back(update+1);                            // Adds target vertex to pathway
     if (distance[target] == INT_MAX) {                      // Checks if pathway exists
         //std::cout << "No pathway!\n";
@@ -186,282 +369,120 @@ std::string Matrix::printPathway(int source, int target, int size) {
 }
 
 /**
- * Takes the size of the number of vertices and returns the minimum vertex cover
+ * Takes the size of the number of vertices and returns the minimum vertex cover, found by SAT
+ * probes starting below the post-optimized greedy cover. If a probe is refused or gives no
+ * answer, the smallest cover found is returned as VC (non-optimal) instead.
  */
 std::string Matrix::vcExact(int size) {
-    std::string cover, minCover;
-    std::vector<int> vertexCover;
-    int n = size;
-    //int count = 0;
-
-    //for (int k = 1; k <= 9; k++) {
-    for (int k = size; k > 0; k--) {
-        n = size;
-        cover = "VC-EXACT: ";
-        //count = 0; // For tracking size of vertex cover
-        vertexCover = {};
-        std::vector<std::vector<Minisat::Lit>> x(k, std::vector<Minisat::Lit>(n));
-        std::vector<Minisat::vec<Minisat::Lit>> clauseOne(k);
-        std::vector<Minisat::vec<Minisat::Lit>> clauseFour(edgeList.size());
-
-        // -- allocate on the heap so that we can reset later if needed
-        std::unique_ptr<Minisat::Solver> solver(new Minisat::Solver());
-
-        for (int i = 0; i < k; i++) {   // row
-            for (int j = 0; j < n; j++) {   // col
-                x[i][j] = Minisat::mkLit(solver->newVar());     // x[i][j] where i is position and j is vertex (backwards from notes)
-            }
-        }
+    ClauseArena arena;
+    AdjacencyList graph = buildAdjacency(size, edgeList);
+    std::vector<int> best = improveCover(graph, bitGreedyVertexCover(adjacency)).cover;
 
-        //std::cout << "Clause 1: \n";
-        // CLAUSE 1: One vertex in each position
-        for (int i = 0; i < k; i++) {
-            //std::cout << "k = " << i+1 << ": ";
-            for (int j = 0; j < n; j++) {
-                clauseOne[i].push(x[i][j]);
-                //std::cout << "x[" << i+1 << "][" << j+1 << "]" << " ";
-            }
-            solver->addClause(clauseOne[i]);
-            //std::cout << std::endl;
-        }  
-
-        // CLAUSE 2: Vertex cannot be in both position p and q
-        //std::cout << "Clause 2: \n";
-        for (int m = 0; m < n; m++) {
-            for (int q = 0; q < k; q++) {
-                for (int p = q+1; p < k; p++) {
-                    solver->addClause(~x[p][m], ~x[q][m]);
-                    //std::cout << "Clause: ~x[" << p+1 << "][" << m+1 << "], ~x[" << q+1 << "][" << m+1 << "]" << std::endl;
-                }
-            }
-        }  
-  
-        // CLAUSE 3: Position m can only have one vertex, p or q
-        //std::cout << "Clause 3: \n";
-        for (int m = 0; m < k; m++) {
-            for (int p = 0; p < n; p++) {
-                for (int q = p+1; q < n; q++) {
-                    solver->addClause(~x[m][p], ~x[m][q]);
-                    //std::cout << "Clause: ~x" << m+1 << "" << p+1 << ", ~x" << m+1 << "" << q+1 << std::endl;
-                }
-            }
-        }  
-        
-        // CLAUSE 4: Check edgelist clause
-        //std::cout << "Clause 4: \n";
-        for (int e = 0; e < edgeList.size(); e++) {
-            //std::cout << "(" << edgeList[e][0]+1 << ", " << edgeList[e][1]+1 << "): ";
-            for (int i = 0; i < k; i++) {
-                clauseFour[e].push(x[i][edgeList[e][0]]);
-                clauseFour[e].push(x[i][edgeList[e][1]]);
-                //std::cout << "x" << i+1 << "" << edgeList[e][0]+1 << " x" << i+1 << "" << edgeList[e][1]+1 << " ";
-            } 
-            solver->addClause(clauseFour[e]);
-            //std::cout << std::endl;
-        }
-
-        bool res = solver->solve();
-        //std::cout << "The result is: " << res << " for k = " << k << "\n";
-        //std::cout << "k = " << k << " ";
-        if (res == 1) {
-            for (int i = 0; i < k; i++) { 
-                for (int j = 0; j < n; j++) { 
-                    //std::cout << "x" << (i + 1) << (j + 1) << "=" << Minisat::toInt(solver->modelValue(x[i][j])) << " ";
-                    if (Minisat::toInt(solver->modelValue(x[i][j])) == 0) {
-                        //std::cout << "x" << (i + 1) << (j + 1) << "=" << Minisat::toInt(solver->modelValue(x[i][j])) << " ";
-                        //cover.append(std::to_string(j+1) + " ");
-                        vertexCover.push_back(j+1);
-                        //count += 1;
-                    }
-                }
-                //std::cout << std::endl;
-            }
-        } else {
-            //cover.append("Failed at k = " + std::to_string(k));
-            break;
-        }
-        
-        std::sort(vertexCover.begin(), vertexCover.end());          // Sort vertex cover
-        for (int i = 0; i < vertexCover.size(); i++) {              // Recording vertex cover
-            cover.append(std::to_string(vertexCover[i]) + " ");
-        }
-        cover.append("(" + std::to_string(vertexCover.size()) + ")");
-        minCover = cover;
-        solver.reset (new Minisat::Solver());
+    if (stats != nullptr) {
+        stats->counters["exact_upper_bound"] = best.size();
     }
-    //std::cout << cover << std::endl;
-    
-    return minCover;
+    SatOutcome outcome = satVertexCover(graph, edgeList, best, memBudget, threads, cubeDepth, arena, stats);
+    if (outcome == SAT_REFUSED) {
+        std::cerr << "Error: Encoding for k = " << best.size() - 1 << " exceeds the memory budget.\n";
+    }
+    return coverFormatter(outcome == SAT_MINIMUM ? "VC-EXACT" : "VC (non-optimal)", best, labels);
 }
 
-/** 
- * Greedy algorithm 1 implementation
+/**
+ * Returns the minimum vertex cover of a forest by leaf greedy, or of a bipartite graph by
+ * Hopcroft-Karp matching and Konig's theorem. Both run in polynomial time.
+ *
+ * @return the cover, empty if the graph has an odd cycle or a self loop and needs an exact search
  */
-std::string Matrix::greedySolver1() {
-    std::string cover = "VC-GREEDY-1: ";
-    std::map<int,std::vector<int>> edgesDict = {};
-    std::vector<int> vertexCover = {};
-    std::vector<int> removeVertex;                          // Storage for vertices to be removed from edgesDict
-    int currentVertex;                                      // Storage for vertex with highest number of adjacent vertice
-    int vertexSize;                                         // Storage for number of adjacent vertice (comparison)
-
-    for (int row = 0; row < graph[0].size(); row++) {       // Create map of edges and adjList
-        int index = 0;                                      // Setting index value to record
-        edgesDict[row+1] = {};
-        for (int col : graph[row]) {                        // Looping through column values of graph
-            index += 1;
-            if (col != 0) {                                 // If index value is adjacent, add to adjList
-                edgesDict[row+1].push_back(index);
-            }
-        }
-    }
-
-    while (edgesDict.size() > 0) {
-        currentVertex = 0;
-        vertexSize = 0;
-        removeVertex = {};
-
-        for (const auto& vertexKey : edgesDict) {           // Searching for vertex with most adjacent vertices
-            if (vertexKey.second.size() > vertexSize) { 
-                currentVertex = vertexKey.first;
-                vertexSize = vertexKey.second.size();
-            }
-        }
-        //std::cout << "Vertex Cover: " << currentVertex << std::endl;
-
-        vertexCover.push_back(currentVertex);               // Recording vertex cover
-        removeVertex.push_back(currentVertex);              // Recording vertex to be removed from edgesDict
-
-        for (const auto& i : edgesDict) {                   // Removing vertex from all other adjacency lists
-            edgesDict[i.first].erase(std::remove(edgesDict[i.first].begin(), edgesDict[i.first].end(), currentVertex), edgesDict[i.first].end()); 
-            if (i.second.size() == 0) {                     // Removing all vertex with empty adjacency lists
-                removeVertex.push_back(i.first);
-            }
-        }
-
-        for (const auto& v : removeVertex) {                // Deleting vertices to be removed from edgesDict
-            edgesDict.erase(v);
-        }
+std::string Matrix::vcPolynomial() {
+    std::string cover;
+    std::vector<int> vertexCover;
+    size_t matching = 0;
 
-        // for (const auto& vertexKey : edgesDict) {           // Print edgesDict
-        //     std::cout << vertexKey.first << ": ";           // Print the key
-        //     for (int adjList : vertexKey.second) {
-        //         std::cout << adjList << " ";                // Print values in the vector
-        //     }
-        //     std::cout << std::endl;
-        // }
+    GraphClass type = polynomialVertexCover(buildAdjacency(row, edgeList), vertexCover, &matching);
+    if (type == CLASS_GENERAL) {
+        return cover;
+    }
+    if (stats != nullptr) {
+        stats->counters[type == CLASS_FOREST ? "forest" : "bipartite_matching"] = type == CLASS_FOREST ? 1 : matching;
+    }
+    return coverFormatter("VC-EXACT", vertexCover, labels);
+}
 
+/**
+ * Returns the minimum vertex cover by dynamic programming over a tree decomposition, in time linear
+ * in the number of vertices on graphs of small treewidth, such as near-trees and road networks.
+ *
+ * @param limit the widest decomposition attempted, 0 to skip
+ * @return the cover, empty if the width or the DP tables exceed their limits and SAT should be used
+ */
+std::string Matrix::vcTreewidth(int limit) {
+    std::string cover;
+    std::vector<int> vertexCover;
+    int width = -1;
+    if (limit <= 0) {
+        return cover;
     }
 
-    std::sort(vertexCover.begin(), vertexCover.end());      // Sort vertex cover
-    for (int i = 0; i < vertexCover.size(); i++) {
-        cover.append(std::to_string(vertexCover[i]) + " ");
+    bool solved = treewidthVertexCover(buildAdjacency(row, edgeList), limit, memBudget, vertexCover, &width);
+    if (stats != nullptr) {
+        stats->counters["treewidth"] = width;
     }
-    cover.append("(" + std::to_string(vertexCover.size()) + ")");
-    
-    return cover;
+    if (!solved) {
+        return cover;
+    }
+    return coverFormatter("VC-EXACT", vertexCover, labels);
 }
 
 /**
- * Greedy algorithm 2 implementation
+ * Returns the minimum vertex cover as the vertices outside a maximum clique of the complement graph.
+ * Faster than vcExact on dense graphs, where the complement is sparse.
  */
-std::string Matrix::greedySolver2() {
-    std::string cover = "VC-GREEDY-2: ";
-    std::map<int,std::vector<int>> edgesDict = {};
-    std::vector<int> vertexCover = {};
-    std::vector<std::array<int,2>> removeEdge;              // Storage for vertices to be removed from edgesDict
-    std::vector<int> removeVertex;                          // Storage for vertices to be removed from edgesDict
-    int x,y, px, py;                                        // Storage for vertex with highest number of adjacent vertice
-    int sum, highestSum;                                    // Storage for number of adjacent vertice (comparison)
-
-    for (int row = 0; row < graph[0].size(); row++) {       // Create map of edges and adjList
-        int index = 0;                                      // Setting index value to record
-        edgesDict[row+1] = {};
-        for (int col : graph[row]) {                        // Looping through column values of graph
-            index += 1;
-            if (col != 0) {                                 // If index value is adjacent, add to adjList
-                edgesDict[row+1].push_back(index);
-            }
-        }
+std::string Matrix::vcClique() {
+    long long nodes = 0;
+    std::vector<int> vertexCover = cliqueVertexCover(adjacency, &nodes);
+
+    if (stats != nullptr) {
+        stats->counters["clique_nodes"] = nodes;
     }
+    return coverFormatter("VC-EXACT", vertexCover, labels);
+}
 
-    while (edgeList.size() > 0) {
-        px = 0;
-        py = 0;
-        highestSum = 0;
-        removeVertex = {};
-        removeEdge = {};
-
-        for (int i = 0; i < edgeList.size(); i++) {         // Searching for edge with most adjacent vertices
-            //std::cout << "(" << edgeList[i][0] << ", " << edgeList[i][1] << ")" << std::endl;
-            sum = 0;
-            x = edgeList[i][0]+1;
-            y = edgeList[i][1]+1;
-            for (const auto& vertexKey : edgesDict) {       // Sums number of adjacent vertice in edge
-                if (vertexKey.first == x || vertexKey.first == y) {
-                    sum += vertexKey.second.size();
-                }
-            }
-            //std::cout << "(" << x << "," << y << ") has " << sum << " adjacent neighbors" << std::endl;
-            if (sum > highestSum) {                         // If vertex pair has most adjacent vertices, record it
-                highestSum = sum;
-                px = x;
-                py = y;
-            }
-        }
+/** 
+ * Greedy algorithm 1 implementation
+ */
+std::string Matrix::greedySolver1() {
+    std::vector<int> vertexCover = improved(bitGreedyVertexCover(adjacency), "greedy1");   // Vertex with most adjacent vertices first
 
-        vertexCover.push_back(px);  
-        vertexCover.push_back(py);
-        removeVertex.push_back(px);              
-        removeVertex.push_back(py);              
-        //std::cout << "Added to vertex cover: " << px << " " << py << std::endl;
-
-        for (const auto& i : edgesDict) {                   // Removing vertex from all other adjacency lists
-            edgesDict[i.first].erase(std::remove(edgesDict[i.first].begin(), edgesDict[i.first].end(), px), edgesDict[i.first].end()); 
-            edgesDict[i.first].erase(std::remove(edgesDict[i.first].begin(), edgesDict[i.first].end(), py), edgesDict[i.first].end()); 
-            if (i.second.size() == 0) {                     // Removing all vertex with empty adjacency lists
-                removeVertex.push_back(i.first);
-            }
-        }
+    return coverFormatter("VC-GREEDY-1", vertexCover, labels);
+}
 
-        for (const auto& v : removeVertex) {                // Deleting vertices to be removed from edgesDict
-            edgesDict.erase(v);
-        }
+/**
+ * Greedy algorithm 2 implementation
+ */
+std::string Matrix::greedySolver2() {
+    std::vector<int> vertexCover = improved(bitGreedyEdgeCover(adjacency, edgeList), "greedy2");   // Edge with most adjacent vertices first
 
-        // for (const auto& vertexKey : edgesDict) {           // Print edgesDict
-        //     std::cout << vertexKey.first << ": ";           // Print the key
-        //     for (int adjList : vertexKey.second) {
-        //         std::cout << adjList << " ";                // Print values in the vector
-        //     }
-        //     std::cout << std::endl;
-        // }
-
-        for (int i = 0; i < edgeList.size(); i++) {         // Records all edges in edgeList that have vertice in vertexCover
-            if (px == edgeList[i][0]+1 || px == edgeList[i][1]+1 || py == edgeList[i][0]+1 || py == edgeList[i][1]+1) {
-                removeEdge.push_back({edgeList[i][0],edgeList[i][1]});
-                //std::cout << "Removed: (" << edgeList[i][0]+1 << "," << edgeList[i][1]+1 << ")" << std::endl;
-            }
-        }
-        
-        for (const auto& edge : removeEdge) {               // Removes edges in edgeList that have been covered
-            auto index = std::find(edgeList.begin(), edgeList.end(), edge);
-            edgeList.erase(index);
-            //std::cout << "Removed: " << edge[0]+1 << "," << edge[1]+1 << std::endl;
-        }
+    return coverFormatter("VC-GREEDY-2", vertexCover, labels);
+}
 
-        // std::cout << "Remains of edgeList: " << std::endl;
-        // for (int i = 0; i < edgeList.size(); i++) {
-        //     std::cout << "(" << edgeList[i][0]+1 << ", " << edgeList[i][1]+1 << ")" << std::endl;
-        // }
-        //std::cout << "Size of edgeList: " << edgeList.size() << std::endl;
-    }
+/**
+ * Returns the minimum weight vertex cover found by branch and bound.
+ */
+std::string Matrix::vcWeightedExact() {
+    long long nodes = 0;
+    std::vector<int> vertexCover = weightedExactCover(buildAdjacency(row, edgeList), vertexWeights, &nodes);
 
-    std::sort(vertexCover.begin(), vertexCover.end());      // Sort vertex cover
-    for (int i = 0; i < vertexCover.size(); i++) {
-        cover.append(std::to_string(vertexCover[i]) + " ");
+    if (stats != nullptr) {
+        stats->counters["weighted_nodes"] = nodes;
     }
-    cover.append("(" + std::to_string(vertexCover.size()) + ")");
-    
-    return cover;
+    return weightedCoverFormatter("VC-WEIGHTED-EXACT", vertexCover, vertexWeights, labels);
 }
 
+/**
+ * Ratio greedy: the vertex with the lowest weight per uncovered edge first
+ */
+std::string Matrix::weightedGreedySolver() {
+    std::vector<int> vertexCover = improved(ratioGreedyCover(buildAdjacency(row, edgeList), vertexWeights), "weighted_greedy");
+    return weightedCoverFormatter("VC-WEIGHTED-GREEDY", vertexCover, vertexWeights, labels);
+}
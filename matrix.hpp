@@ -5,16 +5,31 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <memory>
+
+#include "stats.hpp"
+#include "bitmatrix.hpp"
+#include "pathcache.hpp"
+#include "apsp.hpp"
 
 class Matrix {
     int row;
     int col;
     std::vector<std::vector<int>> graph;
-    std::vector<int> distance;
-    std::vector<int> parent;
+    BitMatrix adjacency;                            // Unweighted copy of graph for the dense-path algorithms
+    std::shared_ptr<const PathTree> tree;           // Shortest path tree of the last dijkstra call
+    PathCache pathCache;                            // Trees of recent sources, cleared when an edge changes
+    std::shared_ptr<const AllPairs> allPairs;       // Set by the A command, cleared when an edge changes
 
     std::vector<std::array<int,3>> data;
     std::vector<std::array<int,2>> edgeList;
+    GraphStats* stats;                              // Optional sink for solver instrumentation
+    long long memBudget;                            // Bytes an encoding may use, 0 for no limit
+    bool improve;                                   // Post-optimize the greedy covers
+    int threads;                                    // Threads building and solving each encoding, 0 for one per hardware thread
+    int cubeDepth;                                  // Vertices decided per cube-and-conquer cube, 0 to solve probes whole
+    std::vector<int> labels;                        // Printed name of each vertex, empty for 1..n
+    std::vector<long long> vertexWeights;           // Cost of each vertex, empty for an unweighted graph
 
 public:
     // Constructor and Destructor
@@ -26,11 +41,31 @@ public:
     void set(int r, int c, int w);                  
     void resize(int r, int c);                      
     void print();                                  
+    void setStats(GraphStats* s);
+    void setMemoryBudget(long long bytes);
+    void setImprove(bool enabled);
+    void setThreads(int count);
+    void setCubeDepth(int depth);
+    void setLabels(const std::vector<int>& names);
+    void setPathCacheBudget(size_t bytes);
+    void setVertexWeight(int v, long long w);
+    bool hasVertexWeights() const;
+    const std::vector<long long>& weights() const;
+    const std::vector<std::array<int,2>>& edges() const;
     void dijkstra(int source);
+    bool allPairsShortestPaths(int threads);
     std::string printPathway(int source, int target, int size);
     std::string greedySolver1();
     std::string greedySolver2();
     std::string vcExact(int size);
+    std::string vcTreewidth(int limit);
+    std::string vcPolynomial();
+    std::string vcClique();
+    std::string vcWeightedExact();
+    std::string weightedGreedySolver();
+
+private:
+    std::vector<int> improved(std::vector<int> cover, const std::string& name);
 };
 
 
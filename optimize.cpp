@@ -0,0 +1,348 @@
+#include <vector>
+#include <algorithm>
+
+#include "optimize.hpp"
+
+/**
+ * CoverImprover Class
+ * Shrinks a valid cover while keeping it valid. For every vertex it tracks how many of its
+ * neighbors are outside the cover, which is the number of edges that removing it would uncover.
+ * Without weights every vertex weighs one.
+ */
+class CoverImprover {
+    const AdjacencyList& graph;
+    std::vector<char> inCover;
+    std::vector<char> loop;                         // Self loop, the vertex can never leave the cover
+    std::vector<int> outside;                       // Neighbors not in the cover
+    std::vector<char> mark;
+    std::vector<char> listed;                       // Already in the list being built
+    std::vector<long long> weight;
+    std::vector<int> changed;                       // Vertices that entered or left the cover since the last takeChanges
+    bool weighted;
+
+public:
+    CoverImprover(const AdjacencyList& g, const std::vector<int>& cover, const std::vector<long long>* weights);
+
+    bool valid() const;
+    long long removeRedundant(const std::vector<int>& scope);
+    long long swapPairs(const std::vector<int>& scan);
+    std::vector<int> takeChanges();
+    std::vector<int> neighborhood(const std::vector<int>& vertices);
+    std::vector<int> swapScan(const std::vector<int>& vertices);
+    std::vector<int> cover() const;
+
+private:
+    void list(int v, std::vector<int>& result);
+    std::vector<int> sortedList(std::vector<int>& result);
+    void add(int v);
+    void remove(int v);
+    bool removable(int v) const;
+    int findPartner(const std::vector<int>& candidates, int u, long long need);
+};
+
+CoverImprover::CoverImprover(const AdjacencyList& g, const std::vector<int>& cover, const std::vector<long long>* weights)
+    : graph(g), inCover(g.n, 0), loop(g.n, 0), outside(g.n, 0), mark(g.n, 0), listed(g.n, 0), weight(g.n, 1), weighted(weights != nullptr) {
+    if (weighted) {
+        weight.assign(weights->begin(), weights->begin() + g.n);
+    }
+    for (int v : cover) {
+        inCover[v] = 1;
+    }
+    for (int v = 0; v < graph.n; v++) {
+        for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+            if (*u == v) {
+                loop[v] = 1;
+            } else if (!inCover[*u]) {
+                ++outside[v];
+            }
+        }
+    }
+}
+
+/**
+ * Returns true if every edge has an endpoint in the cover.
+ */
+bool CoverImprover::valid() const {
+    for (int v = 0; v < graph.n; v++) {
+        if (inCover[v]) {
+            continue;
+        }
+        for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+            if (!inCover[*u]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void CoverImprover::add(int v) {
+    inCover[v] = 1;
+    changed.push_back(v);
+    for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+        if (*u != v) {
+            --outside[*u];
+        }
+    }
+}
+
+void CoverImprover::remove(int v) {
+    inCover[v] = 0;
+    changed.push_back(v);
+    for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+        if (*u != v) {
+            ++outside[*u];
+        }
+    }
+}
+
+bool CoverImprover::removable(int v) const {
+    return inCover[v] && !loop[v] && outside[v] == 0;
+}
+
+/**
+ * Drops every cover vertex of scope whose neighbors are all in the cover. Removing a vertex pins
+ * its neighbors, so candidates are bucketed by degree and the lowest degree goes first, which
+ * pins the fewest; equal degrees keep the order of scope. Runs in O(|scope| + their degrees).
+ * With weights the heaviest candidates go first instead.
+ *
+ * @param scope the vertices to consider
+ * @return the number of vertices removed
+ */
+long long CoverImprover::removeRedundant(const std::vector<int>& scope) {
+    std::vector<int> order;
+    long long removed = 0;
+    int maxDegree = 0;
+
+    for (int v : scope) {
+        if (removable(v)) {
+            maxDegree = std::max(maxDegree, graph.degree(v));
+        }
+    }
+    std::vector<int> start(maxDegree + 2, 0);
+    for (int v : scope) {                                           // Counting sort by degree
+        if (removable(v)) {
+            ++start[graph.degree(v) + 1];
+        }
+    }
+    for (int d = 0; d <= maxDegree; d++) {
+        start[d+1] += start[d];
+    }
+    order.resize(start[maxDegree + 1]);
+    for (int v : scope) {
+        if (removable(v)) {
+            order[start[graph.degree(v)]++] = v;
+        }
+    }
+
+    if (weighted) {
+        std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return weight[a] > weight[b]; });
+    }
+
+    for (int v : order) {
+        if (removable(v)) {                                         // An earlier removal may have pinned it
+            remove(v);
+            ++removed;
+        }
+    }
+
+    return removed;
+}
+
+/**
+ * Returns a candidate that is not adjacent to u and weighs more than need, or -1. Without
+ * weights the scan stops at the first unmarked candidate, so it never looks at more
+ * candidates than u has neighbors.
+ */
+int CoverImprover::findPartner(const std::vector<int>& candidates, int u, long long need) {
+    int partner = -1;
+
+    for (const int* w = graph.begin(u); w != graph.end(u); ++w) {
+        mark[*w] = 1;
+    }
+    for (int c : candidates) {
+        if (c != u && !mark[c] && weight[c] > need) {
+            partner = c;
+            break;
+        }
+    }
+    for (const int* w = graph.begin(u); w != graph.end(u); ++w) {
+        mark[*w] = 0;
+    }
+
+    return partner;
+}
+
+/**
+ * Trades two cover vertices for one outside vertex w wherever both have w as their only
+ * outside neighbor, are not adjacent to each other and together weigh more than w. Every
+ * cover vertex with one outside neighbor is a candidate for exactly one w, so a pass over
+ * every vertex costs O(n + m).
+ *
+ * @param scan the outside vertices to try as w, in order
+ * @return the number of swaps made
+ */
+long long CoverImprover::swapPairs(const std::vector<int>& scan) {
+    std::vector<int> candidates;
+    long long swaps = 0;
+
+    for (int w : scan) {
+        if (inCover[w]) {
+            continue;
+        }
+        candidates.clear();
+        for (const int* u = graph.begin(w); u != graph.end(w); ++u) {
+            if (inCover[*u] && !loop[*u] && outside[*u] == 1) {
+                candidates.push_back(*u);
+            }
+        }
+        if (candidates.size() < 2) {
+            continue;
+        }
+
+        for (int u : candidates) {
+            int v = findPartner(candidates, u, weight[w] - weight[u]);
+            if (v != -1) {
+                add(w);
+                remove(u);
+                remove(v);
+                ++swaps;
+                break;
+            }
+        }
+    }
+
+    return swaps;
+}
+
+/**
+ * Returns the vertices that entered or left the cover since the last call, and forgets them.
+ */
+std::vector<int> CoverImprover::takeChanges() {
+    std::vector<int> result;
+    result.swap(changed);
+    return result;
+}
+
+void CoverImprover::list(int v, std::vector<int>& result) {
+    if (!listed[v]) {
+        listed[v] = 1;
+        result.push_back(v);
+    }
+}
+
+std::vector<int> CoverImprover::sortedList(std::vector<int>& result) {
+    for (int v : result) {
+        listed[v] = 0;
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * Returns the vertices and their neighbors, sorted. Only these can have become redundant.
+ */
+std::vector<int> CoverImprover::neighborhood(const std::vector<int>& vertices) {
+    std::vector<int> result;
+    for (int t : vertices) {
+        list(t, result);
+        for (const int* x = graph.begin(t); x != graph.end(t); ++x) {
+            list(*x, result);
+        }
+    }
+    return sortedList(result);
+}
+
+/**
+ * Returns the outside vertices whose swap candidates may differ after the given vertices changed
+ * sides, sorted: those vertices when outside, their outside neighbors, and the one outside
+ * neighbor of each neighbor that is now a candidate. Any other w fails exactly as it did before,
+ * so later passes only look here instead of at the whole graph.
+ */
+std::vector<int> CoverImprover::swapScan(const std::vector<int>& vertices) {
+    std::vector<int> result;
+    for (int t : vertices) {
+        if (!inCover[t]) {
+            list(t, result);
+        }
+        for (const int* x = graph.begin(t); x != graph.end(t); ++x) {
+            if (!inCover[*x]) {
+                list(*x, result);
+            } else if (!loop[*x] && outside[*x] == 1) {
+                for (const int* y = graph.begin(*x); y != graph.end(*x); ++y) {
+                    if (!inCover[*y]) {
+                        list(*y, result);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return sortedList(result);
+}
+
+std::vector<int> CoverImprover::cover() const {
+    std::vector<int> result;
+    for (int v = 0; v < graph.n; v++) {
+        if (inCover[v]) {
+            result.push_back(v);
+        }
+    }
+    return result;
+}
+
+/**
+ * Post-optimizes a heuristic cover. Redundant vertices are removed, then 2-for-1 swaps are
+ * tried, repeating while the swaps free up new redundant vertices. After the first pass only
+ * the neighborhoods of changed vertices are revisited, so swaps rippling across a long path or
+ * grid cost time in their number rather than one full pass each. Every step lowers the
+ * total weight. The result is checked against every edge; an invalid input or result
+ * returns the input unchanged.
+ *
+ * @param graph the graph
+ * @param cover a vertex cover, vertices numbered from 0
+ * @param weights the weight of each vertex, nullptr to minimize the size
+ * @return the lighter cover and what was done to it
+ */
+ImproveResult improveCover(const AdjacencyList& graph, const std::vector<int>& cover, const std::vector<long long>* weights) {
+    ImproveResult result;
+    result.cover = cover;
+    std::sort(result.cover.begin(), result.cover.end());
+    result.cover.erase(std::unique(result.cover.begin(), result.cover.end()), result.cover.end());
+
+    for (int v : result.cover) {
+        if (v < 0 || v >= graph.n) {
+            return result;
+        }
+    }
+    CoverImprover improver(graph, result.cover, weights);
+    if (!improver.valid()) {
+        return result;
+    }
+
+    std::vector<int> scan(graph.n);
+    for (int v = 0; v < graph.n; v++) {
+        scan[v] = v;
+    }
+    long long swaps = 0;
+    long long removed = improver.removeRedundant(scan);
+    improver.takeChanges();
+    while ((swaps = improver.swapPairs(scan)) > 0) {                // Each swap lowers the weight, so this ends
+        result.swaps += swaps;
+        std::vector<int> changed = improver.takeChanges();
+        removed += improver.removeRedundant(improver.neighborhood(changed));
+        std::vector<int> freed = improver.takeChanges();
+        changed.insert(changed.end(), freed.begin(), freed.end());
+        scan = improver.swapScan(changed);                          // Later passes only revisit what the last one changed
+    }
+
+    if (improver.valid()) {
+        result.cover = improver.cover();
+        result.removed = removed;
+        result.verified = true;
+    } else {
+        result.swaps = 0;
+    }
+
+    return result;
+}
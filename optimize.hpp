@@ -0,0 +1,19 @@
+#ifndef OPTIMIZE_HPP
+#define OPTIMIZE_HPP
+
+#include <vector>
+
+#include "graph.hpp"
+
+// What the post-optimization pass did to a cover
+struct ImproveResult {
+    std::vector<int> cover;                         // Sorted, vertices numbered from 0
+    long long removed = 0;                          // Redundant vertices dropped
+    long long swaps = 0;                            // Two cover vertices traded for one lighter outside vertex
+    bool verified = false;                          // Result checked against every edge
+};
+
+ImproveResult improveCover(const AdjacencyList& graph, const std::vector<int>& cover, const std::vector<long long>* weights = nullptr);
+
+
+#endif
@@ -0,0 +1,106 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "options.hpp"
+
+/**
+ * Returns true and stores the text after '=' if the argument is --name=value.
+ */
+static bool optionValue(const std::string& arg, const std::string& name, std::string& value) {
+    std::string prefix = name + "=";
+    if (arg.compare(0, prefix.size(), prefix) == 0) {
+        value = arg.substr(prefix.size());
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Returns half of the physical memory, the default budget for a single encoding.
+ */
+long long defaultMemoryBudget() {
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || pageSize <= 0) {
+        return 0;
+    }
+    return (long long)pages * pageSize / 2;
+}
+
+/**
+ * Parses the command line arguments of the executables.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments
+ * @return the options, unknown arguments are reported and ignored
+ */
+SolverOptions parseOptions(int argc, const char* argv[]) {
+    SolverOptions options;
+    std::string value;
+    options.memBudget = defaultMemoryBudget();
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--stats") {                                             // JSON lines to stderr
+            options.stats = true;
+        } else if (optionValue(arg, "--stats", value)) {                    // JSON lines appended to a file
+            options.stats = true;
+            options.statsPath = value;
+        } else if (optionValue(arg, "--mem-budget", value)) {              // Budget given in MiB
+            options.memBudget = std::strtoll(value.c_str(), nullptr, 10) * 1024 * 1024;
+        } else if (optionValue(arg, "--path-cache", value)) {             // Budget given in MiB, 0 disables
+            options.pathCache = std::strtoll(value.c_str(), nullptr, 10) * 1024 * 1024;
+        } else if (optionValue(arg, "--exact", value)) {
+            if (value == "sat" || value == "clique" || value == "auto") {
+                options.exact = value;
+            } else {
+                std::cerr << "Error: Unknown exact engine " << value << ". Use sat, clique or auto.\n";
+            }
+        } else if (optionValue(arg, "--quality", value)) {                // Which covers are worth their time
+            if (value == "all" || value == "exact" || value == "heuristic") {
+                options.quality = value;
+            } else {
+                std::cerr << "Error: Unknown quality " << value << ". Use all, exact or heuristic.\n";
+            }
+        } else if (optionValue(arg, "--treewidth", value)) {              // 0 disables the tree decomposition DP
+            options.treewidth = std::atoi(value.c_str());
+        } else if (optionValue(arg, "--cubes", value)) {                  // Up to 2^value cubes per SAT probe, 0 disables
+            options.cubes = std::atoi(value.c_str());
+        } else if (optionValue(arg, "--workers", value)) {                // Worker processes solving stdin graphs, 0 solves them in process
+            options.workers = std::atoi(value.c_str());
+        } else if (optionValue(arg, "--worker-rss", value)) {             // Limit given in MiB
+            options.workerRss = std::strtoll(value.c_str(), nullptr, 10) * 1024 * 1024;
+        } else if (optionValue(arg, "--worker-time", value)) {            // Limit given in seconds
+            options.workerTime = std::atof(value.c_str());
+        } else if (arg == "--approx") {
+            options.approx = true;
+        } else if (optionValue(arg, "--threads", value)) {
+            options.threads = std::atoi(value.c_str());
+        } else if (optionValue(arg, "--input", value)) {
+            options.input = value;
+        } else if (optionValue(arg, "--generate", value)) {               // Spec such as gnp:n=1000,p=0.01,seed=7
+            options.generate = value;
+        } else if (optionValue(arg, "--format", value)) {
+            if (value == "auto" || value == "snap" || value == "dimacs" || value == "metis") {
+                options.format = value;
+            } else {
+                std::cerr << "Error: Unknown format " << value << ". Use snap, dimacs or metis.\n";
+            }
+        } else if (optionValue(arg, "--reorder", value)) {                // Renumbers --input and --generate graphs for locality
+            if (value == "none" || value == "degree" || value == "rcm") {
+                options.reorder = value;
+            } else {
+                std::cerr << "Error: Unknown vertex order " << value << ". Use none, degree or rcm.\n";
+            }
+        } else if (arg == "--no-improve") {                                 // Print heuristic covers as found
+            options.improve = false;
+        } else {
+            std::cerr << "Error: Unknown option " << arg << ".\n";
+        }
+    }
+
+    return options;
+}
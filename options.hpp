@@ -0,0 +1,32 @@
+#ifndef OPTIONS_HPP
+#define OPTIONS_HPP
+
+#include <string>
+
+// Command line options shared by both executables
+struct SolverOptions {
+    bool stats = false;                             // Emit one JSON line of statistics per graph
+    std::string statsPath;                          // Stats destination, stderr when empty
+    long long memBudget = 0;                        // Bytes a single encoding may use, 0 for no limit
+    std::string exact = "sat";                      // Exact engine: sat, clique or auto
+    std::string quality = "all";                    // Covers printed: all, exact (no greedy ones) or heuristic (no search)
+    bool approx = false;                            // Also print the matching based 2-approximation
+    int threads = 0;                                // Worker threads, 0 for one per hardware thread
+    bool improve = true;                            // Post-optimize heuristic covers
+    std::string input;                              // Graph file to solve instead of reading stdin
+    std::string format = "auto";                    // Format of the graph file: auto, snap, dimacs or metis
+    std::string generate;                           // Generator spec of a graph to solve instead of reading stdin
+    long long pathCache = -1;                       // Bytes of cached shortest path trees, -1 for the default
+    int treewidth = 16;                             // Widest tree decomposition solved by DP before SAT, 0 to always use SAT
+    std::string reorder = "none";                   // Vertex renumbering of graph files: none, degree or rcm
+    int cubes = 0;                                  // Vertices decided per cube-and-conquer cube of each SAT probe, 0 to solve probes whole
+    int workers = 0;                                // Worker processes solving the graphs read from stdin, 0 to solve them in process
+    long long workerRss = 0;                        // Resident bytes a worker is restarted at, 0 for no limit
+    double workerTime = 0;                          // Seconds a worker may spend on one graph, 0 for no limit
+};
+
+long long defaultMemoryBudget();
+SolverOptions parseOptions(int argc, const char* argv[]);
+
+
+#endif
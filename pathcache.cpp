@@ -0,0 +1,98 @@
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "pathcache.hpp"
+
+/**
+ * Returns the memory held by the tree's arrays.
+ */
+size_t PathTree::bytes() const {
+    return sizeof(PathTree) + (distance.capacity() + parent.capacity()) * sizeof(int);
+}
+
+/**
+ * PathCache Class
+ * Answers repeated S queries from the same source without running Dijkstra again.
+ *
+ * @param bytes the memory budget, 0 disables caching
+ */
+PathCache::PathCache(size_t bytes) : budget(bytes), used(0), clock(0), hits(0), misses(0) {}
+
+/**
+ * Returns the cached tree of a source and marks it as most recently used.
+ *
+ * @param source the source vertex
+ * @return the tree, nullptr if it is not cached
+ */
+std::shared_ptr<const PathTree> PathCache::find(int source) {
+    auto entry = trees.find(source);
+    if (entry == trees.end()) {
+        ++misses;
+        return nullptr;
+    }
+    ++hits;
+    entry->second.lastUse = ++clock;
+    return entry->second.tree;
+}
+
+/**
+ * Caches a tree, evicting least recently used trees until it fits. A tree larger than the whole
+ * budget is not cached.
+ *
+ * @param tree the tree to cache
+ */
+void PathCache::insert(const std::shared_ptr<const PathTree>& tree) {
+    size_t bytes = tree->bytes();
+    if (bytes > budget) {
+        return;
+    }
+    auto entry = trees.find(tree->source);
+    if (entry != trees.end()) {
+        used -= entry->second.tree->bytes();
+        trees.erase(entry);
+    }
+    evict(bytes);
+    trees[tree->source] = {tree, ++clock};
+    used += bytes;
+}
+
+/**
+ * Drops every tree. Called whenever the graph changes.
+ */
+void PathCache::clear() {
+    trees.clear();
+    used = 0;
+}
+
+/**
+ * Changes the memory budget, evicting trees that no longer fit.
+ *
+ * @param bytes the budget, 0 disables caching
+ */
+void PathCache::setBudget(size_t bytes) {
+    budget = bytes;
+    evict(0);
+}
+
+size_t PathCache::size() const {
+    return trees.size();
+}
+
+/**
+ * Evicts least recently used trees until needed more bytes fit in the budget. A linear scan
+ * finds the oldest tree: there is at most one tree per vertex and each is as large as the
+ * graph, so a full cache holds few trees.
+ */
+void PathCache::evict(size_t needed) {
+    while (!trees.empty() && used + needed > budget) {
+        auto oldest = trees.begin();
+        for (auto entry = trees.begin(); entry != trees.end(); ++entry) {
+            if (entry->second.lastUse < oldest->second.lastUse) {
+                oldest = entry;
+            }
+        }
+        used -= oldest->second.tree->bytes();
+        trees.erase(oldest);
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef PATHCACHE_HPP
+#define PATHCACHE_HPP
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+const size_t DEFAULT_PATH_CACHE = 64 * 1024 * 1024;  // Bytes of shortest path trees kept by default
+
+// Shortest path tree of one source
+struct PathTree {
+    int source = -1;
+    std::vector<int> distance;                      // INT_MAX when unreachable
+    std::vector<int> parent;                        // -1 for the source and unreachable vertices
+
+    size_t bytes() const;
+};
+
+/**
+ * PathCache Class
+ * Keeps the shortest path trees of recently queried sources within a memory budget, evicting the
+ * least recently used tree first. Trees are shared, so one handed out stays valid after eviction.
+ */
+class PathCache {
+    struct Entry {
+        std::shared_ptr<const PathTree> tree;
+        uint64_t lastUse;
+    };
+
+    std::unordered_map<int, Entry> trees;
+    size_t budget;                                  // Bytes, 0 disables caching
+    size_t used;
+    uint64_t clock;
+
+public:
+    long long hits;
+    long long misses;
+
+    explicit PathCache(size_t bytes);
+
+    std::shared_ptr<const PathTree> find(int source);
+    void insert(const std::shared_ptr<const PathTree>& tree);
+    void clear();
+    void setBudget(size_t bytes);
+    size_t size() const;
+
+private:
+    void evict(size_t needed);
+};
+
+
+#endif
@@ -0,0 +1,253 @@
+#include <vector>
+#include <array>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+#include "planner.hpp"
+#include "optimize.hpp"
+#include "matching.hpp"
+#include "treewidth.hpp"
+#include "encoder.hpp"
+
+// Cost model, in milliseconds. The clique constants were fitted to the branch and bound on
+// G(n,p) graphs; the search constants are starting points, the stats plan object records the
+// predicted and actual times they can be refitted from.
+static const double LINEAR_MS_PER_ITEM = 2e-5;              // One pass over a vertex or an edge
+static const double TREEWIDTH_MS_PER_BYTE = 2e-6;           // DP work per byte of its tables
+static const double CLIQUE_MS_PER_NODE = 1e-3;              // Branch and bound node, a few bitset passes
+static const double CLIQUE_LOG_NODES = 1.2;                 // log10 of the nodes of a complete graph
+static const double CLIQUE_LOG_NODES_PER_DEGREE = 0.024;    // log10 of the node growth per unit of complement degree
+static const int CLIQUE_MAX_VERTICES = 1 << 14;             // Larger bit matrices take hundreds of megabytes
+static const double SAT_PROBES = 2;                         // Probes of a typical run: a satisfiable one then the refuted one
+static const double SAT_MS_PER_LITERAL = 5e-5;              // Loading and propagating one clause literal
+static const double SAT_SEARCH_MS = 1;                      // Search of a probe whose bounds already meet
+static const double SAT_LOG_SEARCH_PER_GAP = 0.15;          // log10 of the search growth per vertex between the bounds
+static const double MAX_LOG_MS = 12;                        // Predictions are capped at about 30 years
+static const double AUTO_CUBE_MS = 1000;                    // Predicted search worth splitting into cubes
+static const int AUTO_CUBES_PER_THREAD_BITS = 3;            // About 8 cubes per thread balance uneven cubes
+
+/**
+ * Measures the features of a graph the engine choice depends on: size, density, degrees and
+ * components in one pass, the class test of the polynomial engines, the gap between an improved
+ * greedy cover and the matching lower bound, and the width of the decomposition the DP would use.
+ *
+ * @param graph the graph
+ * @param edges the edges of the graph, vertices numbered from 0
+ * @param treewidthLimit the widest decomposition attempted, 0 to skip
+ * @param threads the threads of the matching, 0 for one per hardware thread
+ * @return the features
+ */
+GraphFeatures graphFeatures(const AdjacencyList& graph, const std::vector<std::array<int,2>>& edges, int treewidthLimit, int threads) {
+    GraphFeatures features;
+    int n = graph.n;
+    features.n = n;
+    features.m = graph.edgeCount();
+    features.density = n > 1 ? 2.0 * features.m / ((double)n * (n - 1)) : 0;
+
+    std::vector<char> seen(n, 0);
+    std::vector<int> queue;
+    queue.reserve(n);
+    for (int s = 0; s < n; s++) {
+        features.maxDegree = std::max(features.maxDegree, graph.degree(s));
+        if (seen[s]) {
+            continue;
+        }
+        ++features.components;
+        seen[s] = 1;
+        queue.clear();
+        queue.push_back(s);
+        for (size_t head = 0; head < queue.size(); head++) {
+            int u = queue[head];
+            for (const int* v = graph.begin(u); v != graph.end(u); ++v) {
+                if (!seen[*v]) {
+                    seen[*v] = 1;
+                    queue.push_back(*v);
+                }
+            }
+        }
+    }
+
+    features.type = classifyGraph(graph);
+    features.upper = improveCover(graph, greedyVertexCover(graph)).cover;
+    features.lower = matchingVertexCover(n, edges, threads).lowerBound;
+
+    TreeDecomposition decomposition;
+    if (treewidthLimit > 0 && (decompose(graph, ELIMINATE_MIN_FILL, treewidthLimit, decomposition) ||
+                               decompose(graph, ELIMINATE_MIN_DEGREE, treewidthLimit, decomposition))) {
+        features.width = decomposition.width;
+        features.dpBytes = treeDpBytes(decomposition);
+    }
+    return features;
+}
+
+/**
+ * Returns 10^logMs milliseconds, capped so that hopeless engines compare equal.
+ */
+static double cappedMs(double logMs) {
+    return std::pow(10.0, std::min(logMs, MAX_LOG_MS));
+}
+
+/**
+ * Returns the memory budget of one SAT encoding, split between the cube workers that each
+ * hold a copy of the clauses.
+ */
+static long long encodingBudget(const SolverOptions& options, int cubeDepth) {
+    if (cubeDepth > 0 && options.memBudget > 0) {
+        return options.memBudget / threadCount(options.threads);
+    }
+    return options.memBudget;
+}
+
+/**
+ * Returns the predicted search time of the SAT probes. It grows exponentially with the gap the
+ * probes have to close, and cubes divide it between the threads.
+ */
+static double satSearchMs(const GraphFeatures& features, const SolverOptions& options, int cubeDepth) {
+    double gap = features.upper.size() > features.lower ? features.upper.size() - features.lower : 0;
+    double search = cappedMs(std::log10(SAT_SEARCH_MS) + SAT_LOG_SEARCH_PER_GAP * gap);
+    if (cubeDepth > 0) {
+        search /= std::min<double>(threadCount(options.threads), std::pow(2.0, cubeDepth));
+    }
+    return search;
+}
+
+/**
+ * Returns the predicted SAT time for one cube depth: loading the first probe's clauses twice
+ * plus the search.
+ */
+static double satMs(const GraphFeatures& features, const SolverOptions& options, int cubeDepth) {
+    int k = std::max<int>(features.upper.size() - 1, 1);
+    Encoding encoding = chooseEncoding(features.n, features.m, k, encodingBudget(options, cubeDepth));
+    if (encoding == ENCODING_NONE) {                                // Still the fallback, it reports the budget itself
+        encoding = ENCODING_COUNTER;
+    }
+    double literals = encodingSize(encoding, features.n, features.m, k).literals;
+    return SAT_PROBES * literals * SAT_MS_PER_LITERAL + satSearchMs(features, options, cubeDepth);
+}
+
+/**
+ * Predicts the time an exact engine takes on a graph, not counting the features already measured.
+ *
+ * @param engine the engine
+ * @param features the features of the graph
+ * @param options the command line options
+ * @return the time in milliseconds, negative if the engine does not apply to the graph
+ */
+double predictEngineMs(ExactEngine engine, const GraphFeatures& features, const SolverOptions& options) {
+    double linear = (features.n + features.m) * LINEAR_MS_PER_ITEM;
+    switch (engine) {
+        case ENGINE_BOUND:
+            return features.upper.size() == features.lower ? 0 : -1;
+        case ENGINE_POLYNOMIAL:
+            return features.type != CLASS_GENERAL ? linear : -1;
+        case ENGINE_TREEWIDTH:
+            if (features.width < 0 || (options.memBudget > 0 && features.dpBytes > (size_t)options.memBudget)) {
+                return -1;
+            }
+            return linear + features.dpBytes * TREEWIDTH_MS_PER_BYTE;
+        case ENGINE_CLIQUE: {
+            if (features.n > CLIQUE_MAX_VERTICES) {
+                return -1;
+            }
+            double complementDegree = (features.n - 1) * (1 - features.density);
+            double logNodes = CLIQUE_LOG_NODES + CLIQUE_LOG_NODES_PER_DEGREE * complementDegree;
+            return cappedMs(std::log10(CLIQUE_MS_PER_NODE) + logNodes);
+        }
+        case ENGINE_SAT:
+            return satMs(features, options, options.cubes);
+        case ENGINE_NONE:
+            return 0;
+    }
+    return -1;
+}
+
+/**
+ * Picks the exact engine predicted to finish first. SAT probes whose predicted search is long
+ * are split into cubes when there are threads to share them and --cubes left the choice open.
+ * With --quality=heuristic only the engines that need no search are considered, and
+ * ENGINE_NONE is picked when neither applies.
+ *
+ * @param features the features of the graph
+ * @param options the command line options
+ * @return the engine, its predicted time and the cube depth of the SAT probes
+ */
+EnginePlan planExactEngine(const GraphFeatures& features, const SolverOptions& options) {
+    EnginePlan plan;
+    plan.cubeDepth = options.cubes;
+    if (options.quality == "heuristic") {
+        plan.engine = ENGINE_NONE;
+        const ExactEngine cheap[] = {ENGINE_BOUND, ENGINE_POLYNOMIAL};
+        for (ExactEngine engine : cheap) {
+            double predicted = predictEngineMs(engine, features, options);
+            if (predicted >= 0) {
+                plan.engine = engine;
+                plan.predictedMs = predicted;
+                break;
+            }
+        }
+        return plan;
+    }
+    int threads = threadCount(options.threads);
+    if (options.cubes == 0 && threads > 1 && satSearchMs(features, options, 0) > AUTO_CUBE_MS) {
+        int bits = 0;
+        while ((1 << bits) < threads) {
+            bits++;
+        }
+        plan.cubeDepth = bits + AUTO_CUBES_PER_THREAD_BITS;
+    }
+    plan.predictedMs = satMs(features, options, plan.cubeDepth);
+
+    const ExactEngine candidates[] = {ENGINE_BOUND, ENGINE_POLYNOMIAL, ENGINE_TREEWIDTH, ENGINE_CLIQUE};
+    for (ExactEngine engine : candidates) {
+        double predicted = predictEngineMs(engine, features, options);
+        if (predicted >= 0 && predicted < plan.predictedMs) {
+            plan.engine = engine;
+            plan.predictedMs = predicted;
+        }
+    }
+    return plan;
+}
+
+/**
+ * Returns the name of an engine as written to the stats.
+ */
+std::string engineName(ExactEngine engine) {
+    switch (engine) {
+        case ENGINE_BOUND:
+            return "bound";
+        case ENGINE_POLYNOMIAL:
+            return "polynomial";
+        case ENGINE_TREEWIDTH:
+            return "treewidth";
+        case ENGINE_CLIQUE:
+            return "clique";
+        case ENGINE_SAT:
+            return "sat";
+        case ENGINE_NONE:
+            return "none";
+    }
+    return "unknown";
+}
+
+/**
+ * Records the engine choice, the features behind it and how the prediction compared.
+ *
+ * @param stats the statistics of the graph
+ * @param features the features of the graph
+ * @param plan the engine choice
+ * @param featuresMs the time spent measuring the features
+ * @param actualMs the time the chosen engine took
+ */
+void recordPlan(GraphStats& stats, const GraphFeatures& features, const EnginePlan& plan, double featuresMs, double actualMs) {
+    stats.plan.engine = engineName(plan.engine);
+    stats.plan.featuresMs = featuresMs;
+    stats.plan.predictedMs = plan.predictedMs;
+    stats.plan.actualMs = actualMs;
+    stats.plan.density = features.density;
+    stats.plan.maxDegree = features.maxDegree;
+    stats.plan.components = features.components;
+    stats.plan.gap = (long long)features.upper.size() - (long long)features.lower;
+    stats.plan.width = features.width;
+    stats.plan.cubeDepth = plan.engine == ENGINE_SAT ? plan.cubeDepth : 0;
+}
@@ -0,0 +1,51 @@
+#ifndef PLANNER_HPP
+#define PLANNER_HPP
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstddef>
+
+#include "graph.hpp"
+#include "bipartite.hpp"
+#include "options.hpp"
+#include "stats.hpp"
+
+enum ExactEngine {
+    ENGINE_BOUND,                                   // Improved greedy cover meets the matching lower bound, already optimal
+    ENGINE_POLYNOMIAL,                              // Forest leaf greedy or Konig's theorem
+    ENGINE_TREEWIDTH,                               // DP over a tree decomposition
+    ENGINE_CLIQUE,                                  // Maximum clique of the complement graph
+    ENGINE_SAT,                                     // SAT probes, the fallback that always applies
+    ENGINE_NONE                                     // No exact cover, --quality=heuristic and no polynomial engine applies
+};
+
+// Cheap measurements of a graph the cost model predicts from, all taken in near linear time
+struct GraphFeatures {
+    int n = 0;
+    size_t m = 0;
+    double density = 0;                             // Edges over n (n - 1) / 2
+    int maxDegree = 0;
+    long long components = 0;
+    GraphClass type = CLASS_GENERAL;
+    std::vector<int> upper;                         // Improved greedy cover, sorted, vertices numbered from 0
+    size_t lower = 0;                               // Maximal matching lower bound
+    int width = -1;                                 // Tree decomposition width, -1 above the --treewidth limit
+    size_t dpBytes = 0;                             // Memory of the DP tables over that decomposition
+};
+
+// Engine picked for a graph and what it is expected to cost
+struct EnginePlan {
+    ExactEngine engine = ENGINE_SAT;
+    double predictedMs = 0;
+    int cubeDepth = 0;                              // Cube depth of the SAT probes, --cubes unless the planner splits them
+};
+
+GraphFeatures graphFeatures(const AdjacencyList& graph, const std::vector<std::array<int,2>>& edges, int treewidthLimit, int threads);
+double predictEngineMs(ExactEngine engine, const GraphFeatures& features, const SolverOptions& options);
+EnginePlan planExactEngine(const GraphFeatures& features, const SolverOptions& options);
+std::string engineName(ExactEngine engine);
+void recordPlan(GraphStats& stats, const GraphFeatures& features, const EnginePlan& plan, double featuresMs, double actualMs);
+
+
+#endif
@@ -0,0 +1,211 @@
+#include <vector>
+#include <array>
+#include <string>
+#include <algorithm>
+
+#include "reorder.hpp"
+
+static const int PERIPHERAL_ROUNDS = 2;             // BFS sweeps spent looking for a far away start vertex, each costs a full pass
+
+/**
+ * Stores the vertex order named by --reorder.
+ *
+ * @return false if the name is unknown
+ */
+bool parseVertexOrder(const std::string& name, VertexOrder& order) {
+    if (name == "none") {
+        order = ORDER_NONE;
+    } else if (name == "degree") {
+        order = ORDER_DEGREE;
+    } else if (name == "rcm") {
+        order = ORDER_RCM;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Returns the vertices by decreasing degree, ties in input order. Counting sort, O(n + max degree).
+ *
+ * @param graph the graph
+ * @return the old vertex placed at each new position
+ */
+std::vector<int> degreeOrder(const AdjacencyList& graph) {
+    int n = graph.n;
+    int maxDegree = 0;
+    for (int v = 0; v < n; v++) {
+        maxDegree = std::max(maxDegree, graph.degree(v));
+    }
+    std::vector<int> start(maxDegree + 2, 0);
+    for (int v = 0; v < n; v++) {
+        start[maxDegree - graph.degree(v) + 1]++;
+    }
+    for (int d = 1; d <= maxDegree + 1; d++) {
+        start[d] += start[d - 1];
+    }
+    std::vector<int> order(n);
+    for (int v = 0; v < n; v++) {
+        order[start[maxDegree - graph.degree(v)]++] = v;
+    }
+    return order;
+}
+
+/**
+ * Runs a BFS from root over its component, marking the vertices with stamp.
+ *
+ * @return the vertices in BFS order, with the index where the last level starts in last
+ */
+static std::vector<int> levelSweep(const AdjacencyList& graph, int root, int stamp, std::vector<int>& seen, size_t& last, int& depth) {
+    std::vector<int> queue(1, root);
+    seen[root] = stamp;
+    last = 0;
+    depth = 0;
+    for (size_t head = 0, end = 1; head < queue.size(); ) {
+        for (; head < end; head++) {
+            int u = queue[head];
+            for (const int* v = graph.begin(u); v != graph.end(u); ++v) {
+                if (seen[*v] != stamp) {
+                    seen[*v] = stamp;
+                    queue.push_back(*v);
+                }
+            }
+        }
+        if (queue.size() > end) {                                   // Next level
+            last = end;
+            end = queue.size();
+            depth++;
+        }
+    }
+    return queue;
+}
+
+/**
+ * Returns the reverse Cuthill-McKee order: every component is numbered by a BFS that visits
+ * neighbors by increasing degree, from a pseudo-peripheral vertex found by the George-Liu
+ * sweeps, and the whole order is reversed. Adjacent vertices end up with close numbers, so
+ * the adjacency rows a traversal touches next are usually already in cache.
+ *
+ * @param graph the graph
+ * @return the old vertex placed at each new position
+ */
+std::vector<int> cuthillMcKeeOrder(const AdjacencyList& graph) {
+    int n = graph.n;
+    std::vector<int> byDegree = degreeOrder(graph);
+    std::reverse(byDegree.begin(), byDegree.end());                 // Components start from low degree vertices
+    std::vector<int> seen(n, 0);
+    std::vector<char> placed(n, 0);
+    std::vector<int> order;
+    std::vector<int> level;
+    order.reserve(n);
+    int stamp = 0;
+
+    for (int s : byDegree) {
+        if (placed[s]) {
+            continue;
+        }
+        int root = s;
+        size_t last = 0;
+        int depth = 0;
+        std::vector<int> component = levelSweep(graph, root, ++stamp, seen, last, depth);
+        for (int round = 1; round < PERIPHERAL_ROUNDS; round++) {  // Restart from the thinnest vertex of the deepest level
+            int candidate = component[last];
+            for (size_t i = last; i < component.size(); i++) {
+                if (graph.degree(component[i]) < graph.degree(candidate)) {
+                    candidate = component[i];
+                }
+            }
+            size_t candidateLast = 0;
+            int candidateDepth = 0;
+            std::vector<int> sweep = levelSweep(graph, candidate, ++stamp, seen, candidateLast, candidateDepth);
+            if (candidateDepth <= depth) {
+                break;
+            }
+            root = candidate;
+            depth = candidateDepth;
+            last = candidateLast;
+            component.swap(sweep);
+        }
+
+        size_t head = order.size();
+        order.push_back(root);
+        placed[root] = 1;
+        for (; head < order.size(); head++) {
+            int u = order[head];
+            level.clear();
+            for (const int* v = graph.begin(u); v != graph.end(u); ++v) {
+                if (!placed[*v]) {
+                    placed[*v] = 1;
+                    level.push_back(*v);
+                }
+            }
+            std::sort(level.begin(), level.end(), [&graph](int a, int b) {
+                return graph.degree(a) < graph.degree(b) || (graph.degree(a) == graph.degree(b) && a < b);
+            });
+            order.insert(order.end(), level.begin(), level.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+/**
+ * Returns the order selected by --reorder, empty for ORDER_NONE.
+ */
+std::vector<int> vertexOrder(const AdjacencyList& graph, VertexOrder order) {
+    if (order == ORDER_DEGREE) {
+        return degreeOrder(graph);
+    } else if (order == ORDER_RCM) {
+        return cuthillMcKeeOrder(graph);
+    }
+    return std::vector<int>();
+}
+
+/**
+ * Renumbers the vertices of a graph so that vertex i becomes the old vertex order[i]. The
+ * labels keep the file ids, so covers are printed in the original numbering, and the edges
+ * are sorted so that passes over the edge list walk the new order too.
+ *
+ * @param graph the graph, renumbered in place
+ * @param order the old vertex placed at each new position, a permutation
+ */
+void relabelGraph(LoadedGraph& graph, const std::vector<int>& order) {
+    int n = graph.n;
+    std::vector<int> position(n);
+    for (int i = 0; i < n; i++) {
+        position[order[i]] = i;
+    }
+
+    std::vector<size_t> start(n + 1, 0);                            // Counting sort by the lower endpoint
+    for (const auto& edge : graph.edges) {
+        start[std::min(position[edge[0]], position[edge[1]]) + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        start[v + 1] += start[v];
+    }
+    std::vector<std::array<int,2>> edges(graph.edges.size());
+    std::vector<size_t> next(start.begin(), start.end() - 1);
+    for (const auto& edge : graph.edges) {
+        int a = position[edge[0]];
+        int b = position[edge[1]];
+        edges[next[std::min(a, b)]++] = {std::min(a, b), std::max(a, b)};
+    }
+    for (int v = 0; v < n; v++) {
+        std::sort(edges.begin() + start[v], edges.begin() + start[v + 1]);
+    }
+    graph.edges.swap(edges);
+
+    std::vector<int> labels(n);
+    for (int i = 0; i < n; i++) {
+        labels[i] = graph.labels.empty() ? order[i] + 1 : graph.labels[order[i]];
+    }
+    graph.labels.swap(labels);
+
+    if (!graph.weights.empty()) {
+        std::vector<long long> weights(n);
+        for (int i = 0; i < n; i++) {
+            weights[i] = graph.weights[order[i]];
+        }
+        graph.weights.swap(weights);
+    }
+}
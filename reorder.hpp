@@ -0,0 +1,23 @@
+#ifndef REORDER_HPP
+#define REORDER_HPP
+
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+#include "loader.hpp"
+
+enum VertexOrder {
+    ORDER_NONE,                                     // Input order
+    ORDER_DEGREE,                                   // Highest degree first, hubs share cache lines
+    ORDER_RCM                                       // Reverse Cuthill-McKee, neighbors get nearby numbers
+};
+
+bool parseVertexOrder(const std::string& name, VertexOrder& order);
+std::vector<int> degreeOrder(const AdjacencyList& graph);
+std::vector<int> cuthillMcKeeOrder(const AdjacencyList& graph);
+std::vector<int> vertexOrder(const AdjacencyList& graph, VertexOrder order);
+void relabelGraph(LoadedGraph& graph, const std::vector<int>& order);
+
+
+#endif
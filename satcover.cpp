@@ -0,0 +1,168 @@
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdlib>
+
+#include "satcover.hpp"
+#include "optimize.hpp"
+#include "matching.hpp"
+#include "cube.hpp"
+// defines Var and Lit
+#include "minisat/core/SolverTypes.h"
+// defines Solver
+#include "minisat/core/Solver.h"
+
+/**
+ * Loads the clauses of an encoding into a solver and seeds its decisions with a phase hint.
+ */
+static void loadSolver(Minisat::Solver& solver, const ClauseArena& arena, long long vars, const std::vector<int>& hint) {
+    Minisat::vec<Minisat::Lit> clause;
+    for (long long v = 0; v < vars; v++) {
+        solver.newVar();                                            // DIMACS variable v+1 is MiniSat variable v
+    }
+    for (size_t c = 0; c < arena.size(); c++) {
+        const int* lits = arena.clause(c);
+        clause.clear();
+        for (size_t i = 0; i < arena.length(c); i++) {
+            clause.push(Minisat::mkLit(std::abs(lits[i]) - 1, lits[i] < 0));
+        }
+        solver.addClause(clause);
+    }
+    for (int v : hint) {
+        solver.setPolarity(v - 1, l_False);                         // MiniSat's polarity is the sign of the decision, l_False decides true
+    }
+}
+
+/**
+ * MinisatCubeWorker Class
+ * Cube-and-conquer worker keeping one MiniSat instance, cubes are passed as assumptions.
+ */
+class MinisatCubeWorker : public CubeWorker {
+    Minisat::Solver solver;
+
+public:
+    MinisatCubeWorker(const ClauseArena& arena, long long vars, const std::vector<int>& hint) {
+        loadSolver(solver, arena, vars, hint);
+    }
+
+    int solve(const std::vector<int>& cube) {
+        Minisat::vec<Minisat::Lit> assumptions;
+        for (int lit : cube) {
+            assumptions.push(Minisat::mkLit(std::abs(lit) - 1, lit < 0));
+        }
+        Minisat::lbool result = solver.solveLimited(assumptions);
+        return result == l_True ? 10 : (result == l_False ? 20 : 0);
+    }
+
+    void interrupt() {
+        solver.interrupt();                                         // Stays set, so later solves return at once
+    }
+
+    bool value(int var) {
+        return solver.modelValue(var - 1) == l_True;
+    }
+
+    void addCounters(ProbeStats& probe) {
+        probe.conflicts += solver.conflicts;
+        probe.decisions += solver.decisions;
+        probe.propagations += solver.propagations;
+        probe.restarts += solver.starts;
+    }
+};
+
+/**
+ * Lowers a vertex cover to a minimum one by SAT probes. The probes start one below the given
+ * cover, since every larger k is satisfiable, and each SAT model is post-optimized, which can
+ * skip several k at once. The best known cover, less one vertex, seeds the decision polarity of
+ * each probe.
+ *
+ * With a cube depth set, each probe is split into cubes solved on the worker threads, which
+ * mostly speeds up the final unsatisfiable probe. Every worker holds its own copy of the
+ * clauses, so they share the memory budget.
+ *
+ * @param graph the graph
+ * @param edges the edges of the graph, vertices numbered from 0
+ * @param best a cover to start from, replaced by the smallest one found, sorted
+ * @param budget the bytes an encoding may use, 0 for no limit
+ * @param threads the threads building and solving each encoding, 0 for one per hardware thread
+ * @param cubeDepth the vertices decided per cube, 0 to solve probes whole
+ * @param arena the clause buffer, reused by every probe and across calls
+ * @param stats receives one ProbeStats per probe, may be nullptr
+ * @return SAT_MINIMUM once a probe is unsatisfiable; otherwise best is the smallest cover found,
+ *         which may not be minimum
+ */
+SatOutcome satVertexCover(const AdjacencyList& graph, const std::vector<std::array<int,2>>& edges, std::vector<int>& best,
+                    long long budget, int threads, int cubeDepth, ClauseArena& arena, GraphStats* stats) {
+    int n = graph.n;
+    if (cubeDepth > 0 && budget > 0) {
+        budget /= threadCount(threads);
+    }
+
+    for (int k = (int)best.size() - 1; k > 0; k = (int)best.size() - 1) {
+        ProbeStats probe;
+        probe.k = k;
+        Stopwatch timer;
+
+        Encoding encoding = chooseEncoding(n, edges.size(), k, budget);
+        if (encoding == ENCODING_NONE) {                            // Neither encoding fits, keep the best cover found so far
+            probe.encoding = encodingName(encoding);
+            probe.result = "refused";
+            if (stats != nullptr) {
+                stats->probes.push_back(probe);
+            }
+            return SAT_REFUSED;
+        }
+        encode(encoding, n, edges, k, arena, threads);
+        EncodingSize encoded = encodingSize(encoding, n, edges.size(), k);
+        std::vector<int> hint = phaseHint(encoding, n, edges, k, best);
+        std::vector<int> model;
+        int result = 0;
+        probe.encoding = encodingName(encoding);
+        probe.vars = encoded.vars;
+        probe.clauses = encoded.clauses;
+
+        if (cubeDepth > 0) {
+            std::vector<std::vector<int>> cubes = splitCubes(encoding, n, edges, k, cubeDepth);
+            probe.encodeMs = timer.elapsedMs();
+            timer.restart();
+            result = conquerCubes(cubes, threads, [&]() { return std::unique_ptr<CubeWorker>(new MinisatCubeWorker(arena, encoded.vars, hint)); },
+                                  [&](CubeWorker& worker) {
+                                      model = decodeCover(encoding, n, k, [&worker](int v) { return worker.value(v); });
+                                  }, &probe);
+            probe.solveMs = timer.elapsedMs();
+            timer.restart();
+        } else {
+            // -- allocate on the heap so that we can reset later if needed
+            std::unique_ptr<Minisat::Solver> solver(new Minisat::Solver());
+            loadSolver(*solver, arena, encoded.vars, hint);
+            probe.encodeMs = timer.elapsedMs();
+
+            timer.restart();
+            result = solver->solve() ? 10 : 20;
+            probe.solveMs = timer.elapsedMs();
+            probe.conflicts = solver->conflicts;                    // Search counters exposed by MiniSat's Solver
+            probe.decisions = solver->decisions;
+            probe.propagations = solver->propagations;
+            probe.restarts = solver->starts;
+
+            timer.restart();
+            if (result == 10) {
+                model = decodeCover(encoding, n, k, [&solver](int v) { return solver->modelValue(v-1) == l_True; });
+            }
+        }
+        probe.result = result == 10 ? "sat" : (result == 20 ? "unsat" : "unknown");
+
+        if (result == 10) {
+            best = improveCover(graph, model).cover;
+        }
+        probe.decodeMs = timer.elapsedMs();
+        if (stats != nullptr) {
+            stats->decodeMs += probe.decodeMs;
+            stats->probes.push_back(probe);
+        }
+        if (result != 10) {
+            return result == 20 ? SAT_MINIMUM : SAT_UNKNOWN;
+        }
+    }
+    return SAT_MINIMUM;                                             // At most one vertex left, no smaller cover has every edge
+}
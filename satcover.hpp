@@ -0,0 +1,22 @@
+#ifndef SATCOVER_HPP
+#define SATCOVER_HPP
+
+#include <vector>
+#include <array>
+
+#include "graph.hpp"
+#include "encoder.hpp"
+#include "stats.hpp"
+
+// How a search by SAT probes ended
+enum SatOutcome {
+    SAT_MINIMUM,                                    // The last probe was unsatisfiable, the cover is minimum
+    SAT_REFUSED,                                    // A probe exceeded the memory budget
+    SAT_UNKNOWN                                     // A probe ended without an answer
+};
+
+SatOutcome satVertexCover(const AdjacencyList& graph, const std::vector<std::array<int,2>>& edges, std::vector<int>& best,
+                    long long budget, int threads, int cubeDepth, ClauseArena& arena, GraphStats* stats = nullptr);
+
+
+#endif
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "sparse.hpp"
+#include "formatter.hpp"
+#include "matching.hpp"
+#include "optimize.hpp"
+#include "weighted.hpp"
+#include "treewidth.hpp"
+#include "bipartite.hpp"
+
+/**
+ * Removes redundant vertices and makes 2-for-1 swaps in a heuristic cover when enabled,
+ * recording the saving under the given name.
+ *
+ * @param weights the vertex weights, nullptr to count vertices
+ */
+std::vector<int> improveHeuristicCover(const AdjacencyList& graph, const std::vector<int>& cover, const SolverOptions& options,
+                                       GraphStats& stats, const std::string& name, const std::vector<long long>* weights) {
+    if (!options.improve) {
+        return cover;
+    }
+    ImproveResult result = improveCover(graph, cover, weights);
+    stats.counters[name + "_removed"] = result.removed;
+    stats.counters[name + "_swaps"] = result.swaps;
+    return result.cover;
+}
+
+/**
+ * Prints the greedy and approximate covers of a graph above MATRIX_LIMIT vertices, or their
+ * weighted counterparts. All run in near linear time on the adjacency lists. Of the exact engines
+ * only the forest, bipartite and tree decomposition ones run, on unweighted graphs they fit.
+ *
+ * @param graph the graph read from a file
+ * @param options the command line options
+ * @param stats the statistics of the graph
+ */
+void solveSparse(const LoadedGraph& graph, const SolverOptions& options, GraphStats& stats) {
+    Stopwatch timer;
+    AdjacencyList adjacency = buildAdjacency(graph.n, graph.edges);
+    stats.kernelMs = timer.elapsedMs();
+
+    bool solved = false;
+    if (graph.weights.empty()) {                        // Forests, bipartite and narrow graphs are still solved exactly
+        timer.restart();
+        std::vector<int> exact;
+        size_t matching = 0;
+        GraphClass type = polynomialVertexCover(adjacency, exact, &matching);
+        solved = type != CLASS_GENERAL;
+        if (solved) {
+            stats.counters[type == CLASS_FOREST ? "forest" : "bipartite_matching"] = type == CLASS_FOREST ? 1 : matching;
+        }
+        if (!solved && options.treewidth > 0 && options.quality != "heuristic") {
+            int width = -1;
+            solved = treewidthVertexCover(adjacency, options.treewidth, options.memBudget, exact, &width);
+            stats.counters["treewidth"] = width;
+        }
+        if (solved) {
+            std::cout << coverFormatter("VC-EXACT", exact, graph.labels) << std::endl;
+            stats.engineMs["exact"] = timer.elapsedMs();
+        }
+    }
+    if (!solved && options.quality != "heuristic") {
+        std::cerr << "Error: " << graph.n << " vertices exceed the exact engines, printing heuristic covers only.\n";
+    }
+
+    if (!graph.weights.empty()) {                       // Ratio greedy and pricing
+        timer.restart();
+        std::vector<int> cover = ratioGreedyCover(adjacency, graph.weights);
+        cover = improveHeuristicCover(adjacency, cover, options, stats, "weighted_greedy", &graph.weights);
+        std::cout << weightedCoverFormatter("VC-WEIGHTED-GREEDY", cover, graph.weights, graph.labels) << std::endl;
+        stats.engineMs["weighted_greedy"] = timer.elapsedMs();
+
+        timer.restart();
+        PricingCover approx = pricingVertexCover(graph.n, graph.edges, graph.weights);
+        approx.cover = improveHeuristicCover(adjacency, approx.cover, options, stats, "weighted_approx", &graph.weights);
+        std::cout << weightedCoverFormatter("VC-WEIGHTED-APPROX", approx.cover, graph.weights, graph.labels) << std::endl;
+        std::cout << "VC-WEIGHTED-APPROX-LB: " << approx.lowerBound << std::endl;
+        stats.engineMs["weighted_approx"] = timer.elapsedMs();
+        stats.counters["pricing_lower_bound"] = approx.lowerBound;
+        return;
+    }
+
+    if (!solved || options.quality != "exact") {
+        timer.restart();
+        std::vector<int> cover = greedyVertexCover(adjacency);
+        cover = improveHeuristicCover(adjacency, cover, options, stats, "greedy1");
+        std::cout << coverFormatter("VC-GREEDY-1", cover, graph.labels) << std::endl;
+        stats.engineMs["greedy1"] = timer.elapsedMs();
+    }
+
+    timer.restart();
+    MatchingCover approx = matchingVertexCover(graph.n, graph.edges, options.threads);
+    approx.cover = improveHeuristicCover(adjacency, approx.cover, options, stats, "approx");
+    std::cout << coverFormatter("VC-APPROX", approx.cover, graph.labels) << std::endl;
+    std::cout << "VC-APPROX-LB: " << approx.lowerBound << std::endl;
+    stats.engineMs["approx"] = timer.elapsedMs();
+    stats.counters["matching_lower_bound"] = approx.lowerBound;
+}
@@ -0,0 +1,19 @@
+#ifndef SPARSE_HPP
+#define SPARSE_HPP
+
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+#include "loader.hpp"
+#include "options.hpp"
+#include "stats.hpp"
+
+static const int MATRIX_LIMIT = 4096;               // Larger graphs skip the dense exact engines and go through solveSparse
+
+std::vector<int> improveHeuristicCover(const AdjacencyList& graph, const std::vector<int>& cover, const SolverOptions& options,
+                                       GraphStats& stats, const std::string& name, const std::vector<long long>* weights = nullptr);
+void solveSparse(const LoadedGraph& graph, const SolverOptions& options, GraphStats& stats);
+
+
+#endif
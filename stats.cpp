@@ -0,0 +1,136 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "stats.hpp"
+
+/**
+ * Stopwatch Class
+ * Measures wall time in milliseconds from construction or the last restart.
+ */
+Stopwatch::Stopwatch() : start(std::chrono::steady_clock::now()) {}
+
+/**
+ * Resets the start point of the stopwatch to now.
+ */
+void Stopwatch::restart() {
+    start = std::chrono::steady_clock::now();
+}
+
+/**
+ * Returns the time elapsed since the start point.
+ *
+ * @return the elapsed time in milliseconds
+ */
+double Stopwatch::elapsedMs() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Formats a millisecond value with microsecond resolution.
+ */
+static std::string formatMs(double ms) {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    out << ms;
+    return out.str();
+}
+
+/**
+ * Serializes the statistics of one graph as a single line of JSON.
+ *
+ * @param stats the statistics recorded for the graph
+ * @return the JSON object without a trailing newline
+ */
+std::string statsToJson(const GraphStats& stats) {
+    std::ostringstream json;
+
+    json << "{\"graph\":" << stats.id
+         << ",\"vertices\":" << stats.vertices
+         << ",\"edges\":" << stats.edges
+         << ",\"parse_ms\":" << formatMs(stats.parseMs)
+         << ",\"kernel_ms\":" << formatMs(stats.kernelMs)
+         << ",\"decode_ms\":" << formatMs(stats.decodeMs);
+
+    json << ",\"engines\":{";                                       // Engine names are plain identifiers, no escaping needed
+    for (auto it = stats.engineMs.begin(); it != stats.engineMs.end(); ++it) {
+        if (it != stats.engineMs.begin()) {
+            json << ",";
+        }
+        json << "\"" << it->first << "\":" << formatMs(it->second);
+    }
+    json << "}";
+
+    json << ",\"counters\":{";
+    for (auto it = stats.counters.begin(); it != stats.counters.end(); ++it) {
+        if (it != stats.counters.begin()) {
+            json << ",";
+        }
+        json << "\"" << it->first << "\":" << it->second;
+    }
+    json << "}";
+
+    if (!stats.plan.engine.empty()) {
+        const PlanStats& p = stats.plan;
+        std::ostringstream density;
+        density.setf(std::ios::fixed);
+        density.precision(6);
+        density << p.density;
+        json << ",\"plan\":{\"engine\":\"" << p.engine << "\""
+             << ",\"features_ms\":" << formatMs(p.featuresMs)
+             << ",\"predicted_ms\":" << formatMs(p.predictedMs)
+             << ",\"actual_ms\":" << formatMs(p.actualMs)
+             << ",\"density\":" << density.str()
+             << ",\"max_degree\":" << p.maxDegree
+             << ",\"components\":" << p.components
+             << ",\"gap\":" << p.gap
+             << ",\"width\":" << p.width
+             << ",\"cube_depth\":" << p.cubeDepth << "}";
+    }
+
+    json << ",\"probes\":[";
+    for (size_t i = 0; i < stats.probes.size(); i++) {
+        const ProbeStats& p = stats.probes[i];
+        if (i != 0) {
+            json << ",";
+        }
+        json << "{\"k\":" << p.k
+             << ",\"encoding\":\"" << p.encoding << "\""
+             << ",\"vars\":" << p.vars
+             << ",\"clauses\":" << p.clauses
+             << ",\"encode_ms\":" << formatMs(p.encodeMs)
+             << ",\"solve_ms\":" << formatMs(p.solveMs)
+             << ",\"decode_ms\":" << formatMs(p.decodeMs)
+             << ",\"result\":\"" << p.result << "\""
+             << ",\"conflicts\":" << p.conflicts
+             << ",\"decisions\":" << p.decisions
+             << ",\"propagations\":" << p.propagations
+             << ",\"restarts\":" << p.restarts
+             << ",\"cubes\":" << p.cubes << "}";
+    }
+    json << "]}";
+
+    return json.str();
+}
+
+/**
+ * Writes the statistics of one graph as a JSON line.
+ *
+ * @param stats the statistics recorded for the graph
+ * @param path the file to append to, stderr when empty
+ */
+void emitStats(const GraphStats& stats, const std::string& path) {
+    if (path.empty()) {
+        std::cerr << statsToJson(stats) << std::endl;
+        return;
+    }
+
+    std::ofstream out(path, std::ios::app);
+    if (out.is_open()) {
+        out << statsToJson(stats) << "\n";
+    } else {
+        std::cerr << "Error: Could not open stats file " << path << ".\n";
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdint>
+
+// Counters and timings for a single SAT call at cover size k
+struct ProbeStats {
+    int k = 0;
+    std::string encoding;
+    long long vars = 0;
+    long long clauses = 0;
+    double encodeMs = 0;
+    double solveMs = 0;
+    double decodeMs = 0;
+    std::string result = "unknown";                 // sat, unsat or timeout
+    uint64_t conflicts = 0;
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+    uint64_t restarts = 0;
+    long long cubes = 0;                            // Cubes the probe was split into, 0 if solved whole
+};
+
+// Engine choice of --exact=auto and how its prediction compared
+struct PlanStats {
+    std::string engine;                             // Empty when the planner did not run
+    double featuresMs = 0;                          // Time spent measuring the graph features
+    double predictedMs = 0;
+    double actualMs = 0;
+    double density = 0;
+    int maxDegree = 0;
+    long long components = 0;
+    long long gap = 0;                              // Improved greedy cover minus the matching lower bound
+    int width = -1;                                 // Tree decomposition width, -1 above the limit
+    int cubeDepth = 0;                              // Cube depth of the SAT probes, 0 if solved whole
+};
+
+// Everything recorded while solving one graph
+struct GraphStats {
+    int id = 0;
+    int vertices = 0;
+    size_t edges = 0;
+    double parseMs = 0;
+    double kernelMs = 0;                            // Work done to shrink/bound the instance before encoding
+    double decodeMs = 0;
+    std::vector<ProbeStats> probes;
+    std::map<std::string,double> engineMs;          // Wall time of each engine run on the graph
+    std::map<std::string,long long> counters;       // Engine specific values (bounds, sizes, ...)
+    PlanStats plan;
+};
+
+class Stopwatch {
+    std::chrono::steady_clock::time_point start;
+
+public:
+    Stopwatch();
+
+    void restart();
+    double elapsedMs() const;
+};
+
+std::string statsToJson(const GraphStats& stats);
+void emitStats(const GraphStats& stats, const std::string& path);
+
+
+#endif
@@ -0,0 +1,364 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <random>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "vc.h"
+#include "graph.hpp"
+#include "encoder.hpp"
+#include "cube.hpp"
+#include "satcover.hpp"
+#include "treewidth.hpp"
+#include "bipartite.hpp"
+#include "loader.hpp"
+
+// defines Solver
+#include "minisat/core/Solver.h"
+
+static int failures = 0;
+static int checks = 0;
+
+// Records a failed expectation with its location, the test goes on
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+static void check(bool passed, const char* expression, const char* file, int line) {
+    checks++;
+    if (!passed) {
+        failures++;
+        std::cerr << "FAIL " << file << ":" << line << ": " << expression << "\n";
+    }
+}
+
+/**
+ * Returns a random graph of n vertices with each pair joined with probability p, numbered from 0.
+ */
+static std::vector<std::array<int,2>> randomGraph(std::mt19937& random, int n, double p) {
+    std::uniform_real_distribution<double> coin(0, 1);
+    std::vector<std::array<int,2>> edges;
+    for (int u = 0; u < n; u++) {
+        for (int v = u + 1; v < n; v++) {
+            if (coin(random) < p) {
+                edges.push_back({u, v});
+            }
+        }
+    }
+    return edges;
+}
+
+/**
+ * Returns the size of a minimum vertex cover by trying every subset, for graphs of at most 20 vertices.
+ */
+static int bruteForceMinimum(int n, const std::vector<std::array<int,2>>& edges) {
+    int best = n;
+    for (unsigned mask = 0; mask < (1u << n); mask++) {
+        int size = __builtin_popcount(mask);
+        if (size >= best) {
+            continue;
+        }
+        bool covered = true;
+        for (const auto& edge : edges) {
+            if (!((mask >> edge[0]) & 1) && !((mask >> edge[1]) & 1)) {
+                covered = false;
+                break;
+            }
+        }
+        if (covered) {
+            best = size;
+        }
+    }
+    return best;
+}
+
+/**
+ * Returns the size of a minimum vertex cover found by SAT probes from the greedy cover.
+ */
+static int satMinimum(const AdjacencyList& graph, const std::vector<std::array<int,2>>& edges, int cubeDepth) {
+    ClauseArena arena;
+    std::vector<int> best = greedyVertexCover(graph);
+    if (satVertexCover(graph, edges, best, 0, 2, cubeDepth, arena) != SAT_MINIMUM || !isVertexCover(graph.n, edges, best)) {
+        return -1;
+    }
+    return best.size();
+}
+
+/**
+ * TestCubeWorker Class
+ * Solves the cubes of a probe with a MiniSat instance of its own, cube literals as assumptions.
+ */
+class TestCubeWorker : public CubeWorker {
+    Minisat::Solver solver;
+
+public:
+    TestCubeWorker(const ClauseArena& arena, long long vars) {
+        Minisat::vec<Minisat::Lit> clause;
+        for (long long v = 0; v < vars; v++) {
+            solver.newVar();
+        }
+        for (size_t c = 0; c < arena.size(); c++) {
+            clause.clear();
+            for (size_t i = 0; i < arena.length(c); i++) {
+                int lit = arena.clause(c)[i];
+                clause.push(Minisat::mkLit(std::abs(lit) - 1, lit < 0));
+            }
+            solver.addClause(clause);
+        }
+    }
+
+    int solve(const std::vector<int>& cube) {
+        Minisat::vec<Minisat::Lit> assumptions;
+        for (int lit : cube) {
+            assumptions.push(Minisat::mkLit(std::abs(lit) - 1, lit < 0));
+        }
+        Minisat::lbool result = solver.solveLimited(assumptions);
+        return result == l_True ? 10 : (result == l_False ? 20 : 0);
+    }
+
+    void interrupt() {
+        solver.interrupt();
+    }
+
+    bool value(int var) {
+        return solver.modelValue(var - 1) == l_True;
+    }
+
+    void addCounters(ProbeStats&) {
+    }
+};
+
+/**
+ * Checks that the forest and bipartite solvers and the tree decomposition DP find covers of the
+ * minimum size, against SAT probes and brute force.
+ */
+static void testPolynomialAndTreewidth() {
+    std::mt19937 random(1);
+    for (int round = 0; round < 60; round++) {
+        int n = 2 + round % 11;
+        std::vector<std::array<int,2>> edges;
+        if (round % 3 == 0) {                                       // Random forest
+            for (int v = 1; v < n; v++) {
+                if (random() % 4 != 0) {
+                    edges.push_back({(int)(random() % v), v});
+                }
+            }
+        } else if (round % 3 == 1) {                                // Random bipartite graph, even and odd vertices
+            for (int u = 0; u < n; u += 2) {
+                for (int v = 1; v < n; v += 2) {
+                    if (random() % 2 == 0) {
+                        edges.push_back({std::min(u, v), std::max(u, v)});
+                    }
+                }
+            }
+        } else {
+            edges = randomGraph(random, n, 0.4);
+        }
+        AdjacencyList graph = buildAdjacency(n, edges);
+        int minimum = bruteForceMinimum(n, edges);
+        CHECK(satMinimum(graph, edges, 0) == minimum);
+
+        std::vector<int> cover;
+        GraphClass type = polynomialVertexCover(graph, cover);
+        if (round % 3 != 2) {
+            CHECK(type != CLASS_GENERAL);
+        }
+        if (type != CLASS_GENERAL) {
+            CHECK(isVertexCover(n, edges, cover));
+            CHECK((int)cover.size() == minimum);
+        }
+
+        std::vector<int> narrow;
+        int width = -1;
+        CHECK(treewidthVertexCover(graph, 16, 0, narrow, &width));
+        CHECK(width >= 0 && width < n);
+        CHECK(isVertexCover(n, edges, narrow));
+        CHECK((int)narrow.size() == minimum);
+    }
+
+    std::vector<std::array<int,2>> triangle = {{0, 1}, {1, 2}, {0, 2}};
+    std::vector<int> cover;
+    CHECK(polynomialVertexCover(buildAdjacency(3, triangle), cover) == CLASS_GENERAL);
+    std::vector<std::array<int,2>> clique = randomGraph(random, 8, 1.0);
+    CHECK(!treewidthVertexCover(buildAdjacency(8, clique), 3, 0, cover));      // Width 7 is above the limit
+}
+
+/**
+ * Checks that cube-and-conquer answers every probe as the whole probe does, for both encodings
+ * and several depths, and that the decoded covers are valid.
+ */
+static void testCubeSoundness() {
+    std::mt19937 random(2);
+    for (int round = 0; round < 30; round++) {
+        int n = 3 + round % 8;
+        std::vector<std::array<int,2>> edges = randomGraph(random, n, 0.2 + 0.1 * (round % 6));
+        int minimum = bruteForceMinimum(n, edges);
+        for (Encoding encoding : {ENCODING_POSITION, ENCODING_COUNTER}) {
+            for (int k = 1; k < n; k++) {
+                ClauseArena arena;
+                encode(encoding, n, edges, k, arena);
+                long long vars = encodingSize(encoding, n, edges.size(), k).vars;
+                for (int depth = 0; depth <= 4; depth++) {
+                    std::vector<std::vector<int>> cubes = depth == 0 ? std::vector<std::vector<int>>(1) : splitCubes(encoding, n, edges, k, depth);
+                    std::vector<int> model;
+                    int result = conquerCubes(cubes, 2, [&]() { return std::unique_ptr<CubeWorker>(new TestCubeWorker(arena, vars)); },
+                                              [&](CubeWorker& worker) {
+                                                  model = decodeCover(encoding, n, k, [&worker](int v) { return worker.value(v); });
+                                              });
+                    CHECK(result == (k >= minimum ? 10 : 20));
+                    if (result == 10) {
+                        CHECK(isVertexCover(n, edges, model));
+                        CHECK((int)model.size() <= k);
+                    }
+                }
+            }
+        }
+        AdjacencyList graph = buildAdjacency(n, edges);
+        CHECK(satMinimum(graph, edges, 3) == minimum);
+    }
+}
+
+/**
+ * Checks the C API: a round trip through every solver, buffer and argument errors, and a solver
+ * context reused across graphs and engines.
+ */
+static void testLibrary() {
+    vc_options options;
+    vc_options_init(&options);
+    options.threads = 2;
+    vc_solver* solver = nullptr;
+    CHECK(vc_solver_create(&options, &solver) == VC_OK && solver != nullptr);
+
+    int edges[] = {0, 3, 1, 2, 1, 0, 1, 4, 3, 1, 0, 2, 4, 0};
+    vc_graph* graph = nullptr;
+    CHECK(vc_graph_create(5, edges, 7, &graph) == VC_OK && graph != nullptr);
+    CHECK(vc_graph_vertices(graph) == 5);
+    CHECK(vc_graph_edges(graph) == 7);
+
+    std::vector<std::array<int,2>> list = {{0, 3}, {1, 2}, {0, 1}, {1, 4}, {1, 3}, {0, 2}, {0, 4}};
+    size_t minimum = bruteForceMinimum(5, list);
+    int cover[5];
+    size_t size = 0;
+    size_t lowerBound = 0;
+    CHECK(vc_exact(solver, graph, cover, 5, &size) == VC_OK);
+    CHECK(size == minimum && isVertexCover(5, list, std::vector<int>(cover, cover + size)));
+    CHECK(std::string(vc_solver_stats(solver)).find("{") == 0);
+    CHECK(vc_greedy(solver, graph, cover, 5, &size) == VC_OK && size >= minimum);
+    CHECK(isVertexCover(5, list, std::vector<int>(cover, cover + size)));
+    CHECK(vc_approx(solver, graph, cover, 5, &size, &lowerBound) == VC_OK && size >= minimum && lowerBound <= minimum);
+    CHECK(isVertexCover(5, list, std::vector<int>(cover, cover + size)));
+
+    CHECK(vc_exact(solver, graph, cover, minimum - 1, &size) == VC_BUFFER_TOO_SMALL && size == minimum);
+    CHECK(vc_exact(solver, graph, nullptr, 0, &size) == VC_BUFFER_TOO_SMALL && size == minimum);
+    CHECK(vc_exact(solver, graph, nullptr, 5, &size) == VC_INVALID_ARGUMENT);
+    CHECK(vc_exact(solver, nullptr, cover, 5, &size) == VC_INVALID_ARGUMENT);
+    CHECK(vc_exact(solver, graph, cover, 5, nullptr) == VC_INVALID_ARGUMENT);
+
+    vc_graph* bad = nullptr;
+    int outside[] = {0, 5};
+    CHECK(vc_graph_create(5, outside, 1, &bad) == VC_INVALID_ARGUMENT && bad == nullptr);
+    options.engine = (vc_engine)7;
+    vc_solver* unknown = nullptr;
+    CHECK(vc_solver_create(&options, &unknown) == VC_INVALID_ARGUMENT && unknown == nullptr);
+    vc_graph_destroy(graph);
+
+    std::mt19937 random(3);
+    for (int engine = VC_ENGINE_SAT; engine <= VC_ENGINE_AUTO; engine++) {
+        options.engine = (vc_engine)engine;
+        vc_solver* reused = nullptr;
+        CHECK(vc_solver_create(&options, &reused) == VC_OK);
+        for (int round = 0; round < 20; round++) {                  // One context, graphs of changing size
+            int n = 1 + round % 12;
+            list = randomGraph(random, n, 0.5);
+            std::vector<int> flat;
+            for (const auto& edge : list) {
+                flat.push_back(edge[0]);
+                flat.push_back(edge[1]);
+            }
+            CHECK(vc_graph_create(n, flat.data(), list.size(), &graph) == VC_OK);
+            std::vector<int> found(n);
+            CHECK(vc_exact(reused, graph, found.data(), n, &size) == VC_OK);
+            found.resize(size);
+            CHECK(isVertexCover(n, list, found));
+            CHECK((int)size == bruteForceMinimum(n, list));
+            vc_graph_destroy(graph);
+        }
+        vc_solver_destroy(reused);
+    }
+    vc_solver_destroy(solver);
+}
+
+/**
+ * Writes text to a new temporary file with the given extension and returns its path.
+ */
+static std::string temporaryFile(const std::string& text, const std::string& extension) {
+    static int count = 0;
+    std::string path = "/tmp/vc-test-" + std::to_string(getpid()) + "-" + std::to_string(count++) + extension;
+    std::ofstream file(path, std::ios::binary);
+    file << text;
+    return path;
+}
+
+/**
+ * Loads text as a graph file, removing the file afterwards.
+ */
+static bool loadText(const std::string& text, const std::string& extension, LoadedGraph& graph, GraphFormat format = FORMAT_AUTO) {
+    std::string path = temporaryFile(text, extension);
+    std::cerr.setstate(std::ios::failbit);                          // Malformed files are expected to print errors
+    bool loaded = loadGraph(path, format, 2, graph);
+    std::cerr.clear();
+    unlink(path.c_str());
+    return loaded;
+}
+
+/**
+ * Checks the SNAP, DIMACS and METIS readers on comments, sparse ids, repeated edges, weights and
+ * malformed input.
+ */
+static void testLoader() {
+    LoadedGraph graph;
+    CHECK(loadText("# comment\n10 30\n30 10\n30 20\n\n20 10\n", ".txt", graph));
+    CHECK(graph.n == 3 && graph.edges.size() == 3);
+    CHECK(graph.labels == std::vector<int>({10, 20, 30}));
+
+    CHECK(loadText("0 2147483647\n", ".txt", graph));               // Sized by the distinct ids, not the largest
+    CHECK(graph.n == 2 && graph.edges.size() == 1 && graph.labels[1] == 2147483647);
+
+    CHECK(loadText("1 2 1700000000\r\n2 3 1700000001\r\n", ".txt", graph));   // Extra columns and CRLF line ends
+    CHECK(graph.n == 3 && graph.edges.size() == 2);
+
+    CHECK(loadText("", ".txt", graph));
+    CHECK(graph.n == 0 && graph.edges.empty());
+    CHECK(!loadText("1 x\n", ".txt", graph));
+    std::cerr.setstate(std::ios::failbit);
+    CHECK(!loadGraph("/nonexistent/graph.txt", FORMAT_SNAP, 1, graph));
+    std::cerr.clear();
+
+    CHECK(loadText("c triangle\np edge 4 3\ne 1 2\ne 2 3\ne 1 3\nn 2 5\n", ".col", graph));
+    CHECK(graph.n == 4 && graph.edges.size() == 3 && graph.labels.empty());
+    CHECK(graph.weights.size() == 4 && graph.weights[1] == 5 && graph.weights[0] == 1);
+    CHECK(loadText("p edge 3 1\ne 1 2\n", ".txt", graph));          // Guessed from the p line
+    CHECK(graph.n == 3);
+    CHECK(!loadText("p edge 2 1\ne 1 3\n", ".col", graph));         // Endpoint above n
+    CHECK(!loadText("p edge 2 1\np edge 2 1\ne 1 2\n", ".col", graph));
+    CHECK(!loadText("e 1 2\n", ".col", graph));
+
+    CHECK(loadText("% path\n3 2\n2\n1 3\n2\n", ".graph", graph));
+    CHECK(graph.n == 3 && graph.edges.size() == 2);
+    CHECK(loadText("3 2 010\n4 2\n7 1 3\n1 2\n", ".metis", graph));
+    CHECK(graph.weights == std::vector<long long>({4, 7, 1}));
+    CHECK(!loadText("", ".graph", graph));
+    CHECK(!loadText("x y\n", ".graph", graph));
+}
+
+int main() {
+    testPolynomialAndTreewidth();
+    testCubeSoundness();
+    testLibrary();
+    testLoader();
+    std::cout << checks - failures << " of " << checks << " checks passed\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <climits>
+
+#include "treewidth.hpp"
+
+static const long long UNELIMINABLE = LLONG_MAX;    // Score of a vertex whose bag would exceed the width limit
+static const int MAX_TABLE_BITS = 30;               // Bag masks, the vertex itself included, fit an unsigned
+
+/**
+ * Returns the elimination score of v, lowest eliminated first.
+ */
+static long long eliminationScore(const std::vector<std::vector<int>>& adjacency, int v, EliminationHeuristic heuristic, int limit) {
+    const std::vector<int>& neighbors = adjacency[v];
+    long long degree = neighbors.size();
+    if (degree > limit) {
+        return UNELIMINABLE;
+    }
+    if (heuristic == ELIMINATE_MIN_DEGREE) {
+        return degree;
+    }
+
+    long long fill = 0;
+    for (size_t i = 0; i < neighbors.size(); i++) {
+        const std::vector<int>& row = adjacency[neighbors[i]];
+        for (size_t j = i + 1; j < neighbors.size(); j++) {
+            if (!std::binary_search(row.begin(), row.end(), neighbors[j])) {
+                fill++;
+            }
+        }
+    }
+    return fill * (limit + 1) + degree;                             // Fill first, ties broken by degree
+}
+
+/**
+ * Computes a tree decomposition by repeatedly eliminating the best scoring vertex, turning its
+ * remaining neighbors into a clique. Stops as soon as every remaining vertex has more than limit
+ * neighbors, so dense graphs are rejected after a few cheap steps.
+ *
+ * Only vertices whose neighborhood or fill can change are rescored: the eliminated vertex's
+ * neighbors, and for min-fill the vertices adjacent to two of them. Neighbors of a vertex above
+ * the limit are not scanned; their fill can only have dropped, so they are merely chosen later.
+ *
+ * @param graph the graph
+ * @param heuristic the elimination order
+ * @param limit the widest separator accepted
+ * @param decomposition receives the order, separators and width
+ * @return false if the width would exceed the limit
+ */
+bool decompose(const AdjacencyList& graph, EliminationHeuristic heuristic, int limit, TreeDecomposition& decomposition) {
+    typedef std::pair<long long,int> Entry;
+    int n = graph.n;
+    std::vector<std::vector<int>> adjacency(n);
+    for (int v = 0; v < n; v++) {
+        for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+            if (*u != v) {                                          // A self loop does not widen a bag
+                adjacency[v].push_back(*u);
+            }
+        }
+    }
+
+    decomposition = TreeDecomposition();
+    decomposition.width = 0;
+    decomposition.order.reserve(n);
+    decomposition.separator.resize(n);
+
+    std::vector<long long> score(n);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for (int v = 0; v < n; v++) {
+        score[v] = eliminationScore(adjacency, v, heuristic, limit);
+        queue.push(Entry(score[v], v));
+    }
+
+    std::vector<char> eliminated(n, 0);
+    std::vector<int> shared(n, 0);                                  // Neighbors a vertex has in the eliminated clique
+    std::vector<int> merged;
+    std::vector<int> rescore;
+    while (!queue.empty()) {
+        Entry top = queue.top();
+        queue.pop();
+        int v = top.second;
+        if (eliminated[v] || top.first != score[v]) {               // Stale entry
+            continue;
+        }
+        if (top.first == UNELIMINABLE) {
+            return false;
+        }
+
+        std::vector<int>& clique = decomposition.separator[v];
+        clique.swap(adjacency[v]);
+        eliminated[v] = 1;
+        decomposition.order.push_back(v);
+        decomposition.width = std::max<int>(decomposition.width, clique.size());
+
+        for (int u : clique) {                                      // Neighbors of v become pairwise adjacent
+            merged.clear();
+            std::set_union(adjacency[u].begin(), adjacency[u].end(), clique.begin(), clique.end(), std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(), merged.end(), [u, v](int w) { return w == u || w == v; }), merged.end());
+            adjacency[u].swap(merged);
+        }
+
+        rescore.assign(clique.begin(), clique.end());
+        if (heuristic == ELIMINATE_MIN_FILL) {
+            for (int u : clique) {
+                shared[u] = -1;                                     // Already rescored
+            }
+            for (int u : clique) {
+                if ((int)adjacency[u].size() > limit) {
+                    continue;
+                }
+                for (int w : adjacency[u]) {
+                    if (shared[w] >= 0 && ++shared[w] == 2) {
+                        rescore.push_back(w);
+                    }
+                }
+            }
+            for (int u : clique) {
+                if ((int)adjacency[u].size() <= limit) {
+                    for (int w : adjacency[u]) {
+                        shared[w] = 0;
+                    }
+                }
+            }
+            for (int u : clique) {
+                shared[u] = 0;
+            }
+        }
+        for (int w : rescore) {
+            long long updated = eliminationScore(adjacency, w, heuristic, limit);
+            if (updated != score[w]) {
+                score[w] = updated;
+                queue.push(Entry(updated, w));
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns the memory the DP needs at most: one table entry and one choice bit per subset of
+ * each separator.
+ */
+size_t treeDpBytes(const TreeDecomposition& decomposition) {
+    size_t bytes = 0;
+    for (const auto& separator : decomposition.separator) {
+        size_t entries = (size_t)1 << separator.size();
+        bytes += entries * sizeof(int) + entries / 8 + 1;
+    }
+    return bytes;
+}
+
+/**
+ * Returns the index of a child's table entry from the bag mask of its parent.
+ */
+static inline unsigned project(unsigned mask, const std::vector<int>& bits) {
+    unsigned index = 0;
+    for (size_t j = 0; j < bits.size(); j++) {
+        index |= ((mask >> bits[j]) & 1u) << j;
+    }
+    return index;
+}
+
+/**
+ * Returns a minimum vertex cover by dynamic programming over a tree decomposition, in time linear
+ * in n and exponential only in the width. Each bag forgets its vertex v: for every subset of the
+ * separator in the cover, table[v] holds the smallest cover of the vertices eliminated below v,
+ * including v, that covers all their edges. v may stay out only if all its neighbors in the
+ * separator are in; the children's separators lie inside v's bag, so their tables are read by
+ * projecting the bag mask.
+ *
+ * @param graph the graph
+ * @param limit the widest separator accepted
+ * @param budget the bytes the tables may use, 0 for no limit
+ * @param cover receives the cover, sorted, vertices numbered from 0
+ * @param width receives the width of the decomposition, -1 if it exceeds the limit
+ * @return false if the width exceeds the limit or the tables the budget, leaving cover unchanged
+ */
+bool treewidthVertexCover(const AdjacencyList& graph, int limit, long long budget, std::vector<int>& cover, int* width) {
+    TreeDecomposition decomposition;
+    limit = std::min(limit, MAX_TABLE_BITS - 1);
+    if (width != nullptr) {
+        *width = -1;
+    }
+    if (!decompose(graph, ELIMINATE_MIN_FILL, limit, decomposition) && !decompose(graph, ELIMINATE_MIN_DEGREE, limit, decomposition)) {
+        return false;
+    }
+    if (width != nullptr) {
+        *width = decomposition.width;
+    }
+    if (budget > 0 && treeDpBytes(decomposition) > (size_t)budget) {
+        return false;
+    }
+
+    int n = graph.n;
+    const std::vector<int>& order = decomposition.order;
+    const std::vector<std::vector<int>>& separator = decomposition.separator;
+    std::vector<int> position(n);
+    for (int i = 0; i < n; i++) {
+        position[order[i]] = i;
+    }
+    std::vector<std::vector<int>> children(n);
+    for (int v = 0; v < n; v++) {                                   // The parent bag is the next separator vertex eliminated
+        if (!separator[v].empty()) {
+            int parent = *std::min_element(separator[v].begin(), separator[v].end(), [&position](int a, int b) { return position[a] < position[b]; });
+            children[parent].push_back(v);
+        }
+    }
+
+    std::vector<std::vector<int>> table(n);
+    std::vector<std::vector<bool>> take(n);                         // Whether v is in the best cover for each mask
+    std::vector<int> bit(n, 0);                                     // Bit of each vertex in the current bag's mask
+    std::vector<std::vector<int>> childBits;
+    for (int v : order) {
+        const std::vector<int>& bag = separator[v];
+        int s = bag.size();
+        unsigned must = 0;                                          // Separator neighbors v needs in the cover if it stays out
+        for (int i = 0; i < s; i++) {
+            bit[bag[i]] = i;
+            if (graph.adjacent(v, bag[i])) {
+                must |= 1u << i;
+            }
+        }
+        bit[v] = s;
+        bool loop = graph.adjacent(v, v);
+
+        childBits.assign(children[v].size(), std::vector<int>());
+        for (size_t c = 0; c < children[v].size(); c++) {
+            for (int u : separator[children[v][c]]) {
+                childBits[c].push_back(bit[u]);
+            }
+        }
+
+        table[v].assign((size_t)1 << s, 0);
+        take[v].assign((size_t)1 << s, false);
+        for (unsigned mask = 0; mask < (1u << s); mask++) {
+            int best = INT_MAX;
+            for (unsigned x = 0; x < 2; x++) {
+                if (x == 0 && (loop || (mask & must) != must)) {    // An edge of v would be left uncovered
+                    continue;
+                }
+                unsigned full = mask | (x << s);
+                int cost = x;
+                for (size_t c = 0; c < children[v].size(); c++) {
+                    cost += table[children[v][c]][project(full, childBits[c])];
+                }
+                if (cost < best) {
+                    best = cost;
+                    take[v][mask] = x == 1;
+                }
+            }
+            table[v][mask] = best;
+        }
+        for (int child : children[v]) {                             // Only the parent reads a table
+            std::vector<int>().swap(table[child]);
+        }
+    }
+
+    std::vector<char> chosen(n, 0);
+    for (int i = n - 1; i >= 0; i--) {                              // Separators are decided before their bags
+        int v = order[i];
+        unsigned mask = 0;
+        for (size_t j = 0; j < separator[v].size(); j++) {
+            mask |= (unsigned)chosen[separator[v][j]] << j;
+        }
+        chosen[v] = take[v][mask];
+    }
+    cover.clear();
+    for (int v = 0; v < n; v++) {
+        if (chosen[v]) {
+            cover.push_back(v);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,29 @@
+#ifndef TREEWIDTH_HPP
+#define TREEWIDTH_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "graph.hpp"
+
+const int DEFAULT_TREEWIDTH_LIMIT = 16;             // Widest bag the DP takes on, its tables hold 2^width entries
+
+enum EliminationHeuristic {
+    ELIMINATE_MIN_DEGREE,                           // Vertex with the fewest remaining neighbors first
+    ELIMINATE_MIN_FILL                              // Vertex whose neighbors miss the fewest edges of a clique first
+};
+
+// Tree decomposition given by an elimination order. The bag of v is v and its separator; the
+// parent bag is that of the first separator vertex eliminated after v.
+struct TreeDecomposition {
+    int width = -1;                                 // Largest separator, the treewidth bound
+    std::vector<int> order;                         // Vertices in elimination order
+    std::vector<std::vector<int>> separator;        // Neighbors of each vertex still present when it is eliminated
+};
+
+bool decompose(const AdjacencyList& graph, EliminationHeuristic heuristic, int limit, TreeDecomposition& decomposition);
+size_t treeDpBytes(const TreeDecomposition& decomposition);
+bool treewidthVertexCover(const AdjacencyList& graph, int limit, long long budget, std::vector<int>& cover, int* width = nullptr);
+
+
+#endif
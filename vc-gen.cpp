@@ -0,0 +1,53 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "generator.hpp"
+#include "formatter.hpp"
+
+/**
+ * Writes generated graphs as V and E commands, ready to pipe into either executable.
+ *
+ *   vc-gen <spec> [<spec> ...] [--count=<c>]
+ *
+ * Each spec is written --count times with seeds seed, seed+1, ... The hidden cover of a planted
+ * graph goes to stderr as a VC-PLANTED line, so stdout stays valid input.
+ */
+int main(const int argc, const char* argv[]) {
+    std::vector<std::string> specs;
+    long long count = 1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 8, "--count=") == 0) {
+            count = std::strtoll(arg.c_str() + 8, nullptr, 10);
+        } else {
+            specs.push_back(arg);
+        }
+    }
+    if (specs.empty()) {
+        std::cerr << "Error: Usage: vc-gen <family>:<key>=<value>,... [--count=<c>]\n";
+        return 1;
+    }
+
+    GeneratorSpec spec;
+    LoadedGraph graph;
+    std::vector<int> planted;
+    for (const std::string& text : specs) {
+        if (!parseGeneratorSpec(text, spec)) {
+            return 1;
+        }
+        for (long long i = 0; i < count; i++) {
+            if (!generateGraph(spec, graph, &planted)) {
+                return 1;
+            }
+            writeGraph(std::cout, graph);
+            if (spec.family == FAMILY_PLANTED) {
+                std::cerr << coverFormatter("VC-PLANTED", planted) << "\n";
+            }
+            spec.seed++;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,310 @@
+#include <vector>
+#include <array>
+#include <string>
+#include <memory>
+#include <new>
+#include <exception>
+#include <algorithm>
+
+#include "vc.h"
+#include "graph.hpp"
+#include "encoder.hpp"
+#include "satcover.hpp"
+#include "bitmatrix.hpp"
+#include "clique.hpp"
+#include "matching.hpp"
+#include "optimize.hpp"
+#include "treewidth.hpp"
+#include "bipartite.hpp"
+#include "planner.hpp"
+#include "options.hpp"
+#include "stats.hpp"
+
+// Graph handed out by vc_graph_create, read only once built
+struct vc_graph {
+    int n;
+    std::vector<std::array<int,2>> edges;           // Deduplicated, lower endpoint first, sorted
+    AdjacencyList adjacency;
+};
+
+// Solver context, everything one call leaves behind for the next
+struct vc_solver {
+    SolverOptions options;
+    ClauseArena arena;                              // Reused by every SAT probe, keeps its buffers between calls
+    GraphStats stats;                               // Of the last call
+    std::string statsJson;
+};
+
+/**
+ * Runs one solve after checking its arguments, turning the exceptions of the C++ engines into
+ * status codes so that none crosses the C boundary. A null cover is accepted with capacity 0,
+ * to ask for the size only.
+ */
+template <class Solve>
+static vc_status guarded(vc_solver* solver, const vc_graph* graph, const int* cover, size_t capacity, size_t* size, Solve solve) {
+    if (solver == nullptr || graph == nullptr || size == nullptr || (cover == nullptr && capacity > 0)) {
+        return VC_INVALID_ARGUMENT;
+    }
+    try {
+        solver->stats = GraphStats();
+        solver->stats.vertices = graph->n;
+        solver->stats.edges = graph->edges.size();
+        vc_status status = solve();
+        solver->statsJson = statsToJson(solver->stats);
+        return status;
+    } catch (const std::bad_alloc&) {
+        return VC_OUT_OF_MEMORY;
+    } catch (const std::exception&) {
+        return VC_INTERNAL_ERROR;
+    }
+}
+
+/**
+ * Copies a cover to the caller's buffer.
+ *
+ * @param status the status to return if the cover fits
+ */
+static vc_status copyCover(const std::vector<int>& found, int* cover, size_t capacity, size_t* size, vc_status status) {
+    *size = found.size();
+    if (found.size() > capacity) {
+        return VC_BUFFER_TOO_SMALL;
+    }
+    std::copy(found.begin(), found.end(), cover);
+    return status;
+}
+
+/**
+ * Fills options with the defaults of the ece650-a4 command line.
+ */
+void vc_options_init(vc_options* options) {
+    if (options == nullptr) {
+        return;
+    }
+    SolverOptions defaults;
+    options->engine = VC_ENGINE_SAT;
+    options->threads = defaults.threads;
+    options->mem_budget = defaultMemoryBudget();
+    options->treewidth = defaults.treewidth;
+    options->cubes = defaults.cubes;
+    options->improve = defaults.improve ? 1 : 0;
+}
+
+/**
+ * Builds a graph from an edge array. Duplicate edges are merged, self loops are kept.
+ *
+ * @param n the number of vertices
+ * @param edges the endpoints of edge i at 2i and 2i+1, numbered from 0
+ * @param m the number of edges
+ * @param graph receives the graph, released with vc_graph_destroy
+ */
+vc_status vc_graph_create(int n, const int* edges, size_t m, vc_graph** graph) {
+    if (graph == nullptr || n < 0 || (edges == nullptr && m > 0)) {
+        return VC_INVALID_ARGUMENT;
+    }
+    *graph = nullptr;
+    try {
+        std::vector<std::array<int,2>> edgeList(m);
+        for (size_t e = 0; e < m; e++) {
+            int a = edges[2 * e];
+            int b = edges[2 * e + 1];
+            if (a < 0 || a >= n || b < 0 || b >= n) {
+                return VC_INVALID_ARGUMENT;
+            }
+            edgeList[e] = {a, b};
+        }
+        std::unique_ptr<vc_graph> built(new vc_graph());
+        built->n = n;
+        built->adjacency = buildAdjacency(n, edgeList);
+        for (int u = 0; u < n; u++) {                               // Adjacency rows are sorted and deduplicated
+            for (const int* v = built->adjacency.begin(u); v != built->adjacency.end(u); ++v) {
+                if (*v >= u) {
+                    built->edges.push_back({u, *v});
+                }
+            }
+        }
+        *graph = built.release();
+        return VC_OK;
+    } catch (const std::bad_alloc&) {
+        return VC_OUT_OF_MEMORY;
+    }
+}
+
+void vc_graph_destroy(vc_graph* graph) {
+    delete graph;
+}
+
+int vc_graph_vertices(const vc_graph* graph) {
+    return graph == nullptr ? 0 : graph->n;
+}
+
+size_t vc_graph_edges(const vc_graph* graph) {
+    return graph == nullptr ? 0 : graph->edges.size();
+}
+
+/**
+ * Creates a solver context.
+ *
+ * @param options the options, NULL for the defaults
+ * @param solver receives the context, released with vc_solver_destroy
+ */
+vc_status vc_solver_create(const vc_options* options, vc_solver** solver) {
+    if (solver == nullptr) {
+        return VC_INVALID_ARGUMENT;
+    }
+    *solver = nullptr;
+    vc_options settings;
+    vc_options_init(&settings);
+    if (options != nullptr) {
+        settings = *options;
+    }
+    if (settings.engine < VC_ENGINE_SAT || settings.engine > VC_ENGINE_AUTO || settings.threads < 0 ||
+        settings.mem_budget < 0 || settings.treewidth < 0 || settings.cubes < 0) {
+        return VC_INVALID_ARGUMENT;
+    }
+    try {
+        std::unique_ptr<vc_solver> created(new vc_solver());
+        SolverOptions& converted = created->options;
+        converted.exact = settings.engine == VC_ENGINE_AUTO ? "auto" : (settings.engine == VC_ENGINE_CLIQUE ? "clique" : "sat");
+        converted.threads = settings.threads;
+        converted.memBudget = settings.mem_budget;
+        converted.treewidth = settings.treewidth;
+        converted.cubes = settings.cubes;
+        converted.improve = settings.improve != 0;
+        *solver = created.release();
+        return VC_OK;
+    } catch (const std::bad_alloc&) {
+        return VC_OUT_OF_MEMORY;
+    }
+}
+
+void vc_solver_destroy(vc_solver* solver) {
+    delete solver;
+}
+
+/**
+ * Writes a minimum vertex cover, found by the same engines in the same order as ece650-a4:
+ * the forest and bipartite solvers first, then the clique branch and bound, the tree
+ * decomposition DP or SAT probes, or with VC_ENGINE_AUTO the engine the planner picks.
+ *
+ * @return VC_OVER_BUDGET with the best cover found if a SAT probe exceeds mem_budget, or
+ *         VC_INTERNAL_ERROR with it if a probe ends without an answer
+ */
+vc_status vc_exact(vc_solver* solver, const vc_graph* graph, int* cover, size_t capacity, size_t* size) {
+    return guarded(solver, graph, cover, capacity, size, [&]() -> vc_status {
+        const SolverOptions& options = solver->options;
+        GraphStats& stats = solver->stats;
+        const AdjacencyList& adjacency = graph->adjacency;
+        Stopwatch timer;
+        std::string exact = options.exact;
+        int cubeDepth = options.cubes;
+        GraphFeatures features;
+        EnginePlan plan;
+        double featuresMs = 0;
+        if (exact == "auto") {
+            features = graphFeatures(adjacency, graph->edges, options.treewidth, options.threads);
+            plan = planExactEngine(features, options);
+            featuresMs = timer.elapsedMs();
+            exact = engineName(plan.engine);
+            cubeDepth = plan.cubeDepth;
+        }
+
+        std::vector<int> found;
+        vc_status status = VC_OK;
+        if (exact == "bound") {                                     // The improved greedy cover meets the matching lower bound
+            found = features.upper;
+        } else if (polynomialVertexCover(adjacency, found) == CLASS_GENERAL) {
+            bool solved = false;
+            if (exact == "clique") {
+                long long nodes = 0;
+                found = cliqueVertexCover(toBitMatrix(graph->n, graph->edges), &nodes);
+                stats.counters["clique_nodes"] = nodes;
+                solved = true;
+            } else if ((options.exact == "sat" || exact == "treewidth") && options.treewidth > 0) {
+                int width = -1;
+                solved = treewidthVertexCover(adjacency, options.treewidth, options.memBudget, found, &width);
+                stats.counters["treewidth"] = width;
+            }
+            if (!solved) {
+                found = improveCover(adjacency, greedyVertexCover(adjacency)).cover;
+                stats.counters["exact_upper_bound"] = found.size();
+                SatOutcome outcome = satVertexCover(adjacency, graph->edges, found, options.memBudget, options.threads, cubeDepth, solver->arena, &stats);
+                if (outcome == SAT_REFUSED) {
+                    status = VC_OVER_BUDGET;
+                } else if (outcome == SAT_UNKNOWN) {
+                    status = VC_INTERNAL_ERROR;
+                }
+            }
+        }
+        stats.engineMs["exact"] = timer.elapsedMs();
+        if (options.exact == "auto") {
+            recordPlan(stats, features, plan, featuresMs, stats.engineMs["exact"] - featuresMs);
+        }
+        return copyCover(found, cover, capacity, size, status);
+    });
+}
+
+/**
+ * Writes the cover of the highest degree first greedy, post-optimized unless improve is off.
+ */
+vc_status vc_greedy(vc_solver* solver, const vc_graph* graph, int* cover, size_t capacity, size_t* size) {
+    return guarded(solver, graph, cover, capacity, size, [&]() -> vc_status {
+        Stopwatch timer;
+        std::vector<int> found = greedyVertexCover(graph->adjacency);
+        if (solver->options.improve) {
+            ImproveResult result = improveCover(graph->adjacency, found);
+            found = result.cover;
+            solver->stats.counters["greedy_removed"] = result.removed;
+            solver->stats.counters["greedy_swaps"] = result.swaps;
+        } else {
+            std::sort(found.begin(), found.end());
+        }
+        solver->stats.engineMs["greedy"] = timer.elapsedMs();
+        return copyCover(found, cover, capacity, size, VC_OK);
+    });
+}
+
+/**
+ * Writes the maximal matching 2-approximation, post-optimized unless improve is off.
+ *
+ * @param lower_bound receives the matching lower bound, no cover is smaller, may be NULL
+ */
+vc_status vc_approx(vc_solver* solver, const vc_graph* graph, int* cover, size_t capacity, size_t* size, size_t* lower_bound) {
+    return guarded(solver, graph, cover, capacity, size, [&]() -> vc_status {
+        Stopwatch timer;
+        MatchingCover approx = matchingVertexCover(graph->n, graph->edges, solver->options.threads);
+        if (solver->options.improve) {
+            ImproveResult result = improveCover(graph->adjacency, approx.cover);
+            approx.cover = result.cover;
+            solver->stats.counters["approx_removed"] = result.removed;
+            solver->stats.counters["approx_swaps"] = result.swaps;
+        }
+        if (lower_bound != nullptr) {
+            *lower_bound = approx.lowerBound;
+        }
+        solver->stats.engineMs["approx"] = timer.elapsedMs();
+        solver->stats.counters["matching_lower_bound"] = approx.lowerBound;
+        return copyCover(approx.cover, cover, capacity, size, VC_OK);
+    });
+}
+
+const char* vc_solver_stats(const vc_solver* solver) {
+    return solver == nullptr ? "" : solver->statsJson.c_str();
+}
+
+const char* vc_status_string(vc_status status) {
+    switch (status) {
+        case VC_OK:
+            return "ok";
+        case VC_INVALID_ARGUMENT:
+            return "invalid argument";
+        case VC_BUFFER_TOO_SMALL:
+            return "buffer too small";
+        case VC_OVER_BUDGET:
+            return "encoding exceeds the memory budget";
+        case VC_OUT_OF_MEMORY:
+            return "out of memory";
+        case VC_INTERNAL_ERROR:
+            return "internal error";
+    }
+    return "unknown status";
+}
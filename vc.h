@@ -0,0 +1,78 @@
+#ifndef VC_H
+#define VC_H
+
+/*
+ * libvc: the vertex cover solvers of ece650-a4 behind a C API, for callers that solve many
+ * graphs in one process. Graphs are built from edge arrays, covers are written to buffers the
+ * caller owns, and a solver context keeps its options and clause buffers across calls.
+ *
+ * Vertices are numbered from 0. A graph may be shared by any number of threads; a solver
+ * context may be used by one thread at a time. No function throws or writes to stdout.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VC_API_VERSION 1
+
+typedef enum vc_status {
+    VC_OK = 0,
+    VC_INVALID_ARGUMENT,                            /* Null pointer, negative size or vertex out of range */
+    VC_BUFFER_TOO_SMALL,                            /* The cover did not fit, *size holds its length */
+    VC_OVER_BUDGET,                                 /* A SAT probe exceeded mem_budget, the cover may not be minimum */
+    VC_OUT_OF_MEMORY,
+    VC_INTERNAL_ERROR
+} vc_status;
+
+typedef enum vc_engine {
+    VC_ENGINE_SAT = 0,                              /* Forest, bipartite and treewidth solvers, then SAT probes */
+    VC_ENGINE_CLIQUE,                               /* Forest and bipartite solvers, then maximum clique of the complement */
+    VC_ENGINE_AUTO                                  /* The engine a cost model predicts to finish first */
+} vc_engine;
+
+typedef struct vc_options {
+    vc_engine engine;                               /* Exact engine */
+    int threads;                                    /* Worker threads, 0 for one per hardware thread */
+    long long mem_budget;                           /* Bytes a single encoding or DP may use, 0 for no limit */
+    int treewidth;                                  /* Widest tree decomposition solved by DP, 0 to skip */
+    int cubes;                                      /* Vertices decided per cube-and-conquer cube, 0 to solve probes whole */
+    int improve;                                    /* Nonzero to post-optimize greedy and approximate covers */
+} vc_options;
+
+typedef struct vc_graph vc_graph;
+typedef struct vc_solver vc_solver;
+
+/* Fills options with the defaults of the ece650-a4 command line */
+void vc_options_init(vc_options* options);
+
+/* Builds a graph of n vertices from m edges, edges holding 2m endpoints */
+vc_status vc_graph_create(int n, const int* edges, size_t m, vc_graph** graph);
+void vc_graph_destroy(vc_graph* graph);
+int vc_graph_vertices(const vc_graph* graph);
+size_t vc_graph_edges(const vc_graph* graph);
+
+/* Creates a solver context, options may be NULL for the defaults */
+vc_status vc_solver_create(const vc_options* options, vc_solver** solver);
+void vc_solver_destroy(vc_solver* solver);
+
+/*
+ * Each solver writes a sorted cover to cover, which holds capacity entries, and its length to
+ * *size. A buffer of vc_graph_vertices(graph) entries always suffices; cover may be NULL only
+ * when capacity is 0.
+ */
+vc_status vc_exact(vc_solver* solver, const vc_graph* graph, int* cover, size_t capacity, size_t* size);
+vc_status vc_greedy(vc_solver* solver, const vc_graph* graph, int* cover, size_t capacity, size_t* size);
+vc_status vc_approx(vc_solver* solver, const vc_graph* graph, int* cover, size_t capacity, size_t* size, size_t* lower_bound);
+
+/* Statistics of the last solve as one line of JSON, valid until the next call on the context */
+const char* vc_solver_stats(const vc_solver* solver);
+const char* vc_status_string(vc_status status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
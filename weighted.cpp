@@ -0,0 +1,331 @@
+#include <vector>
+#include <array>
+#include <queue>
+#include <functional>
+#include <algorithm>
+
+#include "weighted.hpp"
+#include "optimize.hpp"
+
+// Vertex states of the weighted branch and bound
+static const char FREE = 0;
+static const char IN = 1;                           // In the cover
+static const char OUT = 2;                          // Out of the cover, so all its neighbors are in
+
+/**
+ * Returns the total weight of a cover.
+ */
+long long coverWeight(const std::vector<int>& cover, const std::vector<long long>& weights) {
+    long long total = 0;
+    for (int v : cover) {
+        total += weights[v];
+    }
+    return total;
+}
+
+// Ratio greedy queue entry, valid while the vertex still has this many uncovered edges
+struct RatioEntry {
+    long long weight;
+    int degree;
+    int vertex;
+
+    bool operator>(const RatioEntry& other) const {             // Compares weight / degree without division
+        long long lhs = weight * other.degree;
+        long long rhs = other.weight * degree;
+        return lhs != rhs ? lhs > rhs : vertex > other.vertex;
+    }
+};
+
+/**
+ * Repeatedly takes the vertex with the lowest weight per uncovered edge. Entries are pushed again
+ * whenever a degree drops and stale ones are skipped, so it runs in O((n + m) log n).
+ *
+ * @param graph the graph
+ * @param weights the weight of each vertex
+ * @return the cover, sorted
+ */
+std::vector<int> ratioGreedyCover(const AdjacencyList& graph, const std::vector<long long>& weights) {
+    std::priority_queue<RatioEntry, std::vector<RatioEntry>, std::greater<RatioEntry>> queue;
+    std::vector<int> degree(graph.n, 0);
+    std::vector<char> inCover(graph.n, 0);
+    std::vector<int> cover;
+
+    for (int v = 0; v < graph.n; v++) {                             // Self loops force their vertex
+        inCover[v] = graph.adjacent(v, v) ? 1 : 0;
+    }
+    for (int v = 0; v < graph.n; v++) {
+        for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+            degree[v] += (*u != v && !inCover[*u]) ? 1 : 0;
+        }
+        if (!inCover[v] && degree[v] > 0) {
+            queue.push({weights[v], degree[v], v});
+        }
+    }
+
+    while (!queue.empty()) {
+        RatioEntry top = queue.top();
+        queue.pop();
+        int v = top.vertex;
+        if (inCover[v] || degree[v] != top.degree) {                // Stale entry
+            continue;
+        }
+        inCover[v] = 1;
+        for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+            if (!inCover[*u] && --degree[*u] > 0) {
+                queue.push({weights[*u], degree[*u], *u});
+            }
+        }
+    }
+
+    for (int v = 0; v < graph.n; v++) {
+        if (inCover[v]) {
+            cover.push_back(v);
+        }
+    }
+    return cover;
+}
+
+/**
+ * Pricing method: each edge in turn raises its price until one endpoint has paid its full weight.
+ * The paid up vertices cover every edge, and since any cover pays at least the sum of the prices,
+ * they weigh at most twice the minimum.
+ *
+ * @param n the number of vertices
+ * @param edges the edges, vertices numbered from 0
+ * @param weights the weight of each vertex
+ * @return the cover and its lower bound
+ */
+PricingCover pricingVertexCover(int n, const std::vector<std::array<int,2>>& edges, const std::vector<long long>& weights) {
+    std::vector<long long> residual(weights.begin(), weights.begin() + n);
+    std::vector<char> touched(n, 0);
+    PricingCover result;
+
+    for (const auto& edge : edges) {
+        int u = edge[0];
+        int v = edge[1];
+        long long price = std::min(residual[u], residual[v]);
+        residual[u] -= price;
+        if (u != v) {
+            residual[v] -= price;
+        }
+        result.lowerBound += price;
+        touched[u] = 1;
+        touched[v] = 1;
+    }
+    for (int v = 0; v < n; v++) {
+        if (touched[v] && residual[v] == 0) {
+            result.cover.push_back(v);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * WeightedSearch Class
+ * Branch and bound for minimum weight vertex cover. Each node either puts the vertex of highest
+ * remaining degree in the cover or puts all its neighbors in. A pricing pass over the undecided
+ * edges bounds the weight still needed.
+ */
+class WeightedSearch {
+    const AdjacencyList& graph;
+    const std::vector<long long>& weight;
+    std::vector<char> state;
+    std::vector<int> trail;                         // Decided vertices in order, for undoing a branch
+    std::vector<long long> residual;                // Scratch space of the pricing bound
+    long long cost;
+    long long best;
+    std::vector<char> bestState;
+
+public:
+    long long nodes;
+
+    WeightedSearch(const AdjacencyList& g, const std::vector<long long>& w, const std::vector<int>& initial);
+
+    void search();
+    std::vector<int> cover() const;
+
+private:
+    void decide(int v, char s);
+    void undo(size_t mark);
+    int freeDegree(int v, int& neighbor) const;
+    void reduce();
+    long long lowerBound();
+};
+
+WeightedSearch::WeightedSearch(const AdjacencyList& g, const std::vector<long long>& w, const std::vector<int>& initial)
+    : graph(g), weight(w), state(g.n, FREE), residual(g.n, 0), cost(0), best(coverWeight(initial, w)), bestState(g.n, OUT), nodes(0) {
+    for (int v : initial) {
+        bestState[v] = IN;
+    }
+    for (int v = 0; v < graph.n; v++) {
+        if (graph.adjacent(v, v)) {
+            decide(v, IN);
+        }
+    }
+}
+
+/**
+ * Fixes a free vertex. Leaving it out puts its free neighbors in.
+ */
+void WeightedSearch::decide(int v, char s) {
+    state[v] = s;
+    trail.push_back(v);
+    if (s == IN) {
+        cost += weight[v];
+        return;
+    }
+    for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+        if (state[*u] == FREE) {
+            decide(*u, IN);
+        }
+    }
+}
+
+void WeightedSearch::undo(size_t mark) {
+    while (trail.size() > mark) {
+        int v = trail.back();
+        trail.pop_back();
+        if (state[v] == IN) {
+            cost -= weight[v];
+        }
+        state[v] = FREE;
+    }
+}
+
+/**
+ * Returns the number of free neighbors and stores one of them.
+ */
+int WeightedSearch::freeDegree(int v, int& neighbor) const {
+    int degree = 0;
+    for (const int* u = graph.begin(v); u != graph.end(v); ++u) {
+        if (*u != v && state[*u] == FREE) {
+            neighbor = *u;
+            ++degree;
+        }
+    }
+    return degree;
+}
+
+/**
+ * Applies the rules that never lose the optimum until none fires: a free vertex without free
+ * neighbors stays out, a weightless one goes in, and a vertex whose only free neighbor weighs
+ * no more than itself stays out so the neighbor goes in.
+ */
+void WeightedSearch::reduce() {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int v = 0; v < graph.n; v++) {
+            if (state[v] != FREE) {
+                continue;
+            }
+            int neighbor = -1;
+            int degree = freeDegree(v, neighbor);
+            if (degree == 0 || (degree == 1 && weight[neighbor] <= weight[v])) {
+                decide(v, OUT);
+                changed = true;
+            } else if (weight[v] == 0) {
+                decide(v, IN);
+                changed = true;
+            }
+        }
+    }
+}
+
+/**
+ * Sum of the prices of a pricing pass over the edges between free vertices.
+ */
+long long WeightedSearch::lowerBound() {
+    long long bound = 0;
+    for (int v = 0; v < graph.n; v++) {
+        residual[v] = weight[v];
+    }
+    for (int v = 0; v < graph.n; v++) {
+        if (state[v] != FREE) {
+            continue;
+        }
+        for (const int* u = graph.begin(v); u != graph.end(v) && residual[v] > 0; ++u) {
+            if (*u > v && state[*u] == FREE) {
+                long long price = std::min(residual[v], residual[*u]);
+                residual[v] -= price;
+                residual[*u] -= price;
+                bound += price;
+            }
+        }
+    }
+    return bound;
+}
+
+void WeightedSearch::search() {
+    size_t mark = trail.size();
+    ++nodes;
+    reduce();
+
+    if (cost + lowerBound() >= best) {                              // Cannot beat the best cover
+        undo(mark);
+        return;
+    }
+
+    int branch = -1;
+    int maxDegree = 0;
+    long long neighborWeight = 0;
+    for (int v = 0; v < graph.n; v++) {
+        int neighbor;
+        int degree = state[v] == FREE ? freeDegree(v, neighbor) : 0;
+        if (degree > maxDegree) {
+            maxDegree = degree;
+            branch = v;
+        }
+    }
+    if (branch == -1) {                                             // No edges left, every free vertex stays out
+        best = cost;
+        for (int v = 0; v < graph.n; v++) {
+            bestState[v] = state[v] == IN ? IN : OUT;
+        }
+        undo(mark);
+        return;
+    }
+
+    for (const int* u = graph.begin(branch); u != graph.end(branch); ++u) {
+        if (*u != branch && state[*u] == FREE) {
+            neighborWeight += weight[*u];
+        }
+    }
+    char first = weight[branch] <= neighborWeight ? IN : OUT;      // Cheaper branch first
+    for (int side = 0; side < 2; side++) {
+        size_t before = trail.size();
+        decide(branch, side == 0 ? first : (first == IN ? OUT : IN));
+        search();
+        undo(before);
+    }
+    undo(mark);
+}
+
+std::vector<int> WeightedSearch::cover() const {
+    std::vector<int> result;
+    for (int v = 0; v < graph.n; v++) {
+        if (bestState[v] == IN) {
+            result.push_back(v);
+        }
+    }
+    return result;
+}
+
+/**
+ * Returns a minimum weight vertex cover, starting from the post-optimized ratio greedy cover as
+ * the bound to beat.
+ *
+ * @param graph the graph
+ * @param weights the weight of each vertex
+ * @param nodes if not null, receives the number of search nodes
+ * @return the cover, sorted
+ */
+std::vector<int> weightedExactCover(const AdjacencyList& graph, const std::vector<long long>& weights, long long* nodes) {
+    WeightedSearch search(graph, weights, improveCover(graph, ratioGreedyCover(graph, weights), &weights).cover);
+    search.search();
+    if (nodes != nullptr) {
+        *nodes = search.nodes;
+    }
+    return search.cover();
+}
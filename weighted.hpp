@@ -0,0 +1,21 @@
+#ifndef WEIGHTED_HPP
+#define WEIGHTED_HPP
+
+#include <vector>
+#include <array>
+
+#include "graph.hpp"
+
+// A 2-approximate weighted cover and the lower bound that proves it
+struct PricingCover {
+    std::vector<int> cover;                         // Sorted, vertices numbered from 0
+    long long lowerBound = 0;                       // Sum of edge prices, no cover weighs less
+};
+
+long long coverWeight(const std::vector<int>& cover, const std::vector<long long>& weights);
+std::vector<int> ratioGreedyCover(const AdjacencyList& graph, const std::vector<long long>& weights);
+PricingCover pricingVertexCover(int n, const std::vector<std::array<int,2>>& edges, const std::vector<long long>& weights);
+std::vector<int> weightedExactCover(const AdjacencyList& graph, const std::vector<long long>& weights, long long* nodes = nullptr);
+
+
+#endif
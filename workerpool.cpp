@@ -0,0 +1,523 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "workerpool.hpp"
+
+static const size_t RING_BYTES = 1 << 22;           // Each direction of a worker's channel, longer records stream through
+static const size_t READ_CHUNK = 1 << 16;           // Bytes taken from the input or a result ring per step
+static const int LIMIT_POLL_MS = 10;                // Interval of the resident memory checks
+static const int IDLE_WAIT_MS = 1;                  // Supervisor sleep when nothing moved
+static const int IDLE_SPINS = 64;                   // Worker yields before it starts sleeping on an empty ring
+static const int JOBS_PER_WORKER = 2;               // Input read ahead, bounds the memory of queued jobs
+
+typedef std::chrono::steady_clock Clock;
+
+// Positions of a single producer, single consumer byte ring in shared memory. Both count the
+// bytes moved since the last reset, so the ring is empty when they are equal. Each sits on
+// its own cache line; 64-bit atomics are lock-free, so they work across processes.
+struct RingHeader {
+    alignas(64) std::atomic<uint64_t> head;         // Written by the producer
+    alignas(64) std::atomic<uint64_t> tail;         // Written by the consumer
+};
+
+/**
+ * ByteRing Class
+ * Lock-free byte queue between two processes. Reads and writes never block: they move as many
+ * bytes as the ring holds or has room for, and the caller retries with the rest.
+ */
+class ByteRing {
+    RingHeader* header;
+    char* data;
+
+public:
+    ByteRing() : header(nullptr), data(nullptr) {}
+    ByteRing(RingHeader* h, char* d) : header(h), data(d) {}
+
+    size_t write(const char* bytes, size_t length) {
+        uint64_t head = header->head.load(std::memory_order_relaxed);
+        uint64_t tail = header->tail.load(std::memory_order_acquire);
+        size_t count = std::min<size_t>(length, RING_BYTES - (head - tail));
+        size_t start = head % RING_BYTES;
+        size_t first = std::min(count, RING_BYTES - start);         // Up to the end of the buffer, then from its start
+        std::memcpy(data + start, bytes, first);
+        std::memcpy(data, bytes + first, count - first);
+        header->head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t read(char* bytes, size_t length) {
+        uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        uint64_t head = header->head.load(std::memory_order_acquire);
+        size_t count = std::min<size_t>(length, head - tail);
+        size_t start = tail % RING_BYTES;
+        size_t first = std::min(count, RING_BYTES - start);
+        std::memcpy(bytes, data + start, first);
+        std::memcpy(bytes + first, data, count - first);
+        header->tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Empties the ring, only while no other process uses it
+    void reset() {
+        header->head.store(0);
+        header->tail.store(0);
+    }
+};
+
+// Framing of jobs and results in the rings, followed by outBytes and then errBytes of text
+struct RecordHeader {
+    int64_t index;                                  // Job number, -1 asks the worker to exit
+    int64_t graphsBefore;
+    uint64_t outBytes;                              // The job's commands, or the worker's standard output
+    uint64_t errBytes;                              // The worker's standard error, 0 for jobs
+};
+
+// Commands from one V command up to the next
+struct Job {
+    long long index;
+    int graphsBefore;
+    std::string text;
+};
+
+struct JobResult {
+    std::string out;
+    std::string err;
+};
+
+// Supervisor side of one worker process
+struct Worker {
+    pid_t pid = -1;
+    void* memory = nullptr;                         // Shared mapping holding both ring headers and buffers
+    ByteRing jobs;                                  // Supervisor to worker
+    ByteRing results;                               // Worker to supervisor
+    long long job = -1;                             // Job being solved, -1 when idle
+    int graphsBefore = 0;
+    std::string sending;                            // Record of the job, sent as the ring drains
+    size_t sent = 0;
+    std::string received;                           // Result bytes not yet forming a whole record
+    Clock::time_point started;
+    Clock::time_point checked;
+};
+
+/**
+ * Waits a little for the other side of a ring, yielding first and then sleeping.
+ */
+static void backoff(int& spins) {
+    if (++spins < IDLE_SPINS) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
+
+/**
+ * Moves bytes through a ring until all are moved, from the worker side.
+ *
+ * @return false if the supervisor died, the worker then exits
+ */
+static bool writeAll(ByteRing& ring, const char* bytes, size_t length, pid_t parent) {
+    int spins = 0;
+    while (length > 0) {
+        size_t count = ring.write(bytes, length);
+        bytes += count;
+        length -= count;
+        if (count > 0) {
+            spins = 0;
+        } else if (getppid() != parent) {
+            return false;
+        } else {
+            backoff(spins);
+        }
+    }
+    return true;
+}
+
+static bool readAll(ByteRing& ring, char* bytes, size_t length, pid_t parent) {
+    int spins = 0;
+    while (length > 0) {
+        size_t count = ring.read(bytes, length);
+        bytes += count;
+        length -= count;
+        if (count > 0) {
+            spins = 0;
+        } else if (getppid() != parent) {
+            return false;
+        } else {
+            backoff(spins);
+        }
+    }
+    return true;
+}
+
+/**
+ * Main loop of a worker process: solves jobs with the standard streams captured and sends
+ * back what they printed, until asked to exit or the supervisor is gone.
+ */
+static void runWorker(ByteRing& jobs, ByteRing& results, pid_t parent, const JobHandler& handler) {
+    RecordHeader header;
+    while (readAll(jobs, (char*)&header, sizeof(header), parent) && header.index >= 0) {
+        std::string job(header.outBytes, '\0');
+        if (!readAll(jobs, &job[0], job.size(), parent)) {
+            return;
+        }
+
+        std::ostringstream out;
+        std::ostringstream err;
+        std::streambuf* coutBuffer = std::cout.rdbuf(out.rdbuf());
+        std::streambuf* cerrBuffer = std::cerr.rdbuf(err.rdbuf());
+        handler(job, header.graphsBefore);
+        std::cout.rdbuf(coutBuffer);
+        std::cerr.rdbuf(cerrBuffer);
+
+        std::string printed = out.str();
+        std::string errors = err.str();
+        RecordHeader result = {header.index, header.graphsBefore, printed.size(), errors.size()};
+        if (!writeAll(results, (const char*)&result, sizeof(result), parent) ||
+            !writeAll(results, printed.data(), printed.size(), parent) ||
+            !writeAll(results, errors.data(), errors.size(), parent)) {
+            return;
+        }
+    }
+}
+
+/**
+ * Maps the shared channel of a worker. It outlives the worker's processes, a restarted worker
+ * gets the same rings back empty.
+ */
+static bool mapChannel(Worker& worker) {
+    size_t bytes = 2 * sizeof(RingHeader) + 2 * RING_BYTES;
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+    char* base = (char*)memory;
+    RingHeader* jobHeader = new (base) RingHeader();
+    RingHeader* resultHeader = new (base + sizeof(RingHeader)) RingHeader();
+    char* data = base + 2 * sizeof(RingHeader);
+    worker.memory = memory;
+    worker.jobs = ByteRing(jobHeader, data);
+    worker.results = ByteRing(resultHeader, data + RING_BYTES);
+    worker.jobs.reset();
+    worker.results.reset();
+    return true;
+}
+
+static void unmapChannel(Worker& worker) {
+    if (worker.memory != nullptr) {
+        munmap(worker.memory, 2 * sizeof(RingHeader) + 2 * RING_BYTES);
+        worker.memory = nullptr;
+    }
+}
+
+/**
+ * Forks a worker process on an empty channel.
+ *
+ * @return false if the process could not be created
+ */
+static bool spawnWorker(Worker& worker, pid_t parent, const JobHandler& handler) {
+    worker.jobs.reset();
+    worker.results.reset();
+    worker.job = -1;
+    worker.sending.clear();
+    worker.sent = 0;
+    worker.received.clear();
+
+    std::cout.flush();                                              // The child must not print the supervisor's buffered output
+    std::cerr.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        runWorker(worker.jobs, worker.results, parent, handler);
+        _exit(0);
+    }
+    worker.pid = pid;
+    worker.checked = Clock::now();
+    return true;
+}
+
+/**
+ * Kills a worker process and waits for it.
+ */
+static void killWorker(Worker& worker) {
+    if (worker.pid > 0) {
+        kill(worker.pid, SIGKILL);
+        waitpid(worker.pid, nullptr, 0);
+        worker.pid = -1;
+    }
+}
+
+/**
+ * Returns the resident memory of a process, 0 if it cannot be read.
+ */
+static long long residentBytes(pid_t pid) {
+    std::ifstream statm("/proc/" + std::to_string(pid) + "/statm");
+    long long size = 0;
+    long long resident = 0;
+    if (!(statm >> size >> resident)) {
+        return 0;
+    }
+    return resident * sysconf(_SC_PAGE_SIZE);
+}
+
+/**
+ * Reads the results a worker has sent so far and stores every complete one.
+ *
+ * @return true if any bytes arrived
+ */
+static bool collectResults(Worker& worker, std::map<long long, JobResult>& finished, std::vector<char>& buffer) {
+    bool moved = false;
+    for (size_t count = worker.results.read(buffer.data(), buffer.size()); count > 0; count = worker.results.read(buffer.data(), buffer.size())) {
+        worker.received.append(buffer.data(), count);
+        moved = true;
+    }
+    while (worker.received.size() >= sizeof(RecordHeader)) {
+        RecordHeader header;
+        std::memcpy(&header, worker.received.data(), sizeof(header));
+        size_t total = sizeof(header) + header.outBytes + header.errBytes;
+        if (worker.received.size() < total) {
+            break;
+        }
+        JobResult& result = finished[header.index];
+        result.out = worker.received.substr(sizeof(header), header.outBytes);
+        result.err = worker.received.substr(sizeof(header) + header.outBytes, header.errBytes);
+        worker.received.erase(0, total);
+        worker.job = -1;
+    }
+    return moved;
+}
+
+/**
+ * Checks a worker against its limits and for an unexpected exit.
+ *
+ * @return the error to report for its job, empty if the worker is fine
+ */
+static std::string workerFailure(Worker& worker, const WorkerLimits& limits, Clock::time_point now) {
+    std::ostringstream error;
+    int status = 0;
+    if (waitpid(worker.pid, &status, WNOHANG) == worker.pid) {
+        worker.pid = -1;
+        error << "Error: Worker crashed on graph " << worker.graphsBefore + 1;
+        if (WIFSIGNALED(status)) {
+            error << " with signal " << WTERMSIG(status);
+        } else {
+            error << " with exit status " << WEXITSTATUS(status);
+        }
+        error << ", restarting it.\n";
+        return error.str();
+    }
+    if (worker.job < 0) {
+        return "";
+    }
+    if (limits.seconds > 0 && std::chrono::duration<double>(now - worker.started).count() > limits.seconds) {
+        error << "Error: Graph " << worker.graphsBefore + 1 << " exceeded the worker time limit of " << limits.seconds << " s, restarting its worker.\n";
+        return error.str();
+    }
+    if (limits.rssBytes > 0 && now - worker.checked >= std::chrono::milliseconds(LIMIT_POLL_MS)) {
+        worker.checked = now;
+        if (residentBytes(worker.pid) > limits.rssBytes) {
+            error << "Error: Graph " << worker.graphsBefore + 1 << " exceeded the worker memory limit of " << limits.rssBytes / (1024 * 1024) << " MiB, restarting its worker.\n";
+            return error.str();
+        }
+    }
+    return "";
+}
+
+/**
+ * JobSplitter Class
+ * Cuts the input into jobs at every V command, so that each job holds one graph and the
+ * commands on it. Lines before the first V command form a job of their own.
+ */
+class JobSplitter {
+    std::string line;                               // Input after the last complete line
+    Job current;
+    int graphs = 0;                                 // E commands seen
+    long long count = 0;                            // Jobs started
+
+public:
+    JobSplitter() {
+        current.index = -1;
+        current.graphsBefore = 0;
+    }
+
+    long long jobs() const {
+        return count;
+    }
+
+    void feed(const char* bytes, size_t length, std::deque<Job>& pending) {
+        for (size_t i = 0; i < length; i++) {
+            line.push_back(bytes[i]);
+            if (bytes[i] == '\n') {
+                addLine(pending);
+            }
+        }
+    }
+
+    void finish(std::deque<Job>& pending) {
+        if (!line.empty()) {
+            line.push_back('\n');
+            addLine(pending);
+        }
+        if (current.index >= 0) {
+            pending.push_back(current);
+        }
+        current.index = -1;
+    }
+
+private:
+    void addLine(std::deque<Job>& pending) {
+        size_t first = line.find_first_not_of(" \t\r");
+        char command = first == std::string::npos ? '\0' : line[first];
+        if (current.index < 0 || command == 'V') {
+            if (current.index >= 0) {
+                pending.push_back(current);
+            }
+            current.index = count++;
+            current.graphsBefore = graphs;
+            current.text.clear();
+        }
+        current.text += line;
+        if (command == 'E') {
+            graphs++;
+        }
+        line.clear();
+    }
+};
+
+/**
+ * Solves the graphs read from an input on a pool of worker processes. The input is cut into
+ * jobs at every V command; each idle worker is sent the next job through a shared memory ring
+ * and returns what it printed through another, and the results are printed in input order. A
+ * worker that crashes, or exceeds the resident memory or wall time limit on a job, is killed
+ * and restarted, and only that job is lost and reported.
+ *
+ * @param input the file descriptor the commands are read from
+ * @param workers the number of worker processes
+ * @param limits the limits each worker is restarted at
+ * @param handler runs the commands of one job, in a worker process
+ * @return the number of jobs lost, -1 if the workers could not be started
+ */
+int superviseWorkers(int input, int workers, const WorkerLimits& limits, const JobHandler& handler) {
+    pid_t self = getpid();
+    std::vector<Worker> pool(std::max(workers, 1));
+    for (Worker& worker : pool) {
+        if (!mapChannel(worker) || !spawnWorker(worker, self, handler)) {
+            std::cerr << "Error: Could not start the worker processes.\n";
+            for (Worker& started : pool) {
+                killWorker(started);
+                unmapChannel(started);
+            }
+            return -1;
+        }
+    }
+
+    std::deque<Job> pending;
+    std::map<long long, JobResult> finished;
+    JobSplitter splitter;
+    std::vector<char> buffer(READ_CHUNK);
+    long long printed = 0;
+    int failed = 0;
+    bool inputOpen = true;
+
+    while (inputOpen || !pending.empty() || printed < splitter.jobs()) {
+        bool progress = false;
+        bool wantInput = inputOpen && pending.size() < pool.size() * JOBS_PER_WORKER;
+        struct pollfd descriptor = {input, POLLIN, 0};
+        if (wantInput && poll(&descriptor, 1, 0) > 0) {
+            ssize_t count = read(input, buffer.data(), buffer.size());
+            if (count > 0) {
+                splitter.feed(buffer.data(), count, pending);
+            } else if (count == 0 || errno != EINTR) {                  // End of the input
+                splitter.finish(pending);
+                inputOpen = false;
+            }
+            progress = true;
+        }
+
+        Clock::time_point now = Clock::now();
+        for (Worker& worker : pool) {
+            progress |= collectResults(worker, finished, buffer);
+            std::string failure = workerFailure(worker, limits, now);
+            if (!failure.empty()) {
+                if (worker.job >= 0) {                              // An idle worker is only replaced
+                    finished[worker.job].err = failure;
+                    failed++;
+                }
+                killWorker(worker);
+                if (!spawnWorker(worker, self, handler)) {
+                    std::cerr << "Error: Could not restart a worker process.\n";
+                    inputOpen = false;
+                    pending.clear();
+                    printed = splitter.jobs();
+                    break;
+                }
+                progress = true;
+            }
+            if (worker.job < 0 && !pending.empty()) {                   // Hand the next job to the idle worker
+                Job& job = pending.front();
+                RecordHeader header = {job.index, job.graphsBefore, job.text.size(), 0};
+                worker.sending.assign((const char*)&header, sizeof(header));
+                worker.sending += job.text;
+                worker.sent = 0;
+                worker.job = job.index;
+                worker.graphsBefore = job.graphsBefore;
+                worker.started = now;
+                pending.pop_front();
+            }
+            if (worker.sent < worker.sending.size()) {
+                size_t count = worker.jobs.write(worker.sending.data() + worker.sent, worker.sending.size() - worker.sent);
+                worker.sent += count;
+                progress |= count > 0;
+            }
+        }
+
+        for (auto it = finished.find(printed); it != finished.end(); it = finished.find(printed)) {
+            std::cout << it->second.out << std::flush;
+            std::cerr << it->second.err;
+            finished.erase(it);
+            printed++;
+            progress = true;
+        }
+        if (!progress) {                                            // Sleep until input arrives or the wait ends
+            poll(&descriptor, wantInput ? 1 : 0, IDLE_WAIT_MS);
+        }
+    }
+
+    for (Worker& worker : pool) {                                   // Every worker is idle, ask them to exit
+        if (worker.pid > 0) {
+            RecordHeader stop = {-1, 0, 0, 0};
+            const char* bytes = (const char*)&stop;
+            size_t sent = 0;
+            Clock::time_point deadline = Clock::now() + std::chrono::seconds(1);
+            while (sent < sizeof(stop) && Clock::now() < deadline) {
+                sent += worker.jobs.write(bytes + sent, sizeof(stop) - sent);
+            }
+            int status = 0;
+            if (sent < sizeof(stop) || waitpid(worker.pid, &status, 0) != worker.pid) {
+                killWorker(worker);
+            }
+            worker.pid = -1;
+        }
+        unmapChannel(worker);
+    }
+    return failed;
+}
@@ -0,0 +1,20 @@
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <string>
+#include <functional>
+
+// Limits a worker process is killed and restarted at
+struct WorkerLimits {
+    long long rssBytes = 0;                         // Resident memory of the worker, 0 for no limit
+    double seconds = 0;                             // Wall time of one job, 0 for no limit
+};
+
+// Runs the commands of one job in a worker process, printing to std::cout and std::cerr. The
+// second argument is the number of E commands in the input before the job, to number graphs.
+typedef std::function<void(const std::string& job, int graphsBefore)> JobHandler;
+
+int superviseWorkers(int input, int workers, const WorkerLimits& limits, const JobHandler& handler);
+
+
+#endif